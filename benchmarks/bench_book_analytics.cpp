@@ -0,0 +1,71 @@
+#include "bench_util.hpp"
+#include "book_analytics.hpp"
+#include "book_recorder.hpp"
+#include "order_book.hpp"
+#include <random>
+#include <vector>
+
+// Cost of keeping spread, depth bands, imbalance and VWAPs current per book
+// update: the incremental analytics against recomputing from full copies
+// (what RecorderLayout::summarize does), as the book grows.
+
+static const Exchange kVenues[] = {Exchange::COINBASE, Exchange::GEMINI, Exchange::BINANCE, Exchange::KRAKEN};
+
+static void fillBook(OrderBook& book, size_t depth) {
+    std::mt19937_64 rng(depth);
+    std::uniform_int_distribution<Quantity> size_dist(QUANTITY_SCALE / 100, QUANTITY_SCALE);
+    for (size_t v = 0; v < 4; ++v) {
+        std::vector<PriceLevel> bids;
+        std::vector<PriceLevel> asks;
+        for (size_t i = 0; i < depth / 4; ++i) {
+            Price step = static_cast<Price>(i * 4 + v) * 25;
+            bids.emplace_back(9999900 - step, size_dist(rng), kVenues[v]);
+            asks.emplace_back(10000100 + step, size_dist(rng), kVenues[v]);
+        }
+        book.replaceExchange(kVenues[v], bids, asks);
+    }
+}
+
+int main() {
+    std::cout << "=== Book Analytics Benchmark ===\n";
+    RecorderLayout recompute;
+    std::vector<int64_t> row;
+
+    for (size_t depth : {1000u, 10000u, 100000u}) {
+        OrderBook plain;
+        OrderBook tracked;
+        fillBook(plain, depth);
+        fillBook(tracked, depth);
+        BookAnalytics analytics(tracked);
+        const uint64_t rebuilds = analytics.rebuilds();
+
+        // A delta-feed style update: one venue's size near the top moves
+        uint64_t iters = depth <= 1000 ? 200000 : depth <= 10000 ? 100000 : 50000;
+        uint64_t n = 0;
+        auto edit = [&n](OrderBook& book) {
+            Price price = 10000100 + static_cast<Price>(n % 16) * 25;
+            book.setAskLevel(price, QUANTITY_SCALE / 2 + static_cast<Quantity>(n % 7), Exchange::KRAKEN);
+            ++n;
+        };
+
+        std::cout << "\nDepth " << depth << " per side, one level changes:\n";
+        double book_only = bench::nsPerOp([&] { edit(plain); }, iters);
+        bench::printRow("book edit alone", book_only);
+        double full = bench::nsPerOp([&] {
+            edit(plain);
+            recompute.summarize(plain, 0, row);
+            bench::doNotOptimize(row.data());
+        }, depth <= 10000 ? iters / 50 : iters / 500);
+        bench::printRow("edit + full recompute from copies", full);
+        double incremental = bench::nsPerOp([&] { edit(tracked); }, iters);
+        bench::printRow("edit + incremental analytics", incremental, full);
+        bench::printRow("  analytics share of the update", incremental - book_only);
+        double read = bench::nsPerOp([&] {
+            bench::doNotOptimize(analytics.snapshot().vwaps[2].buy.total_cost);
+        }, iters);
+        bench::printRow("snapshot() read", read);
+        std::cout << "  window rebuilds during updates: " << analytics.rebuilds() - rebuilds
+                  << ", column fallbacks: " << analytics.fallbacks() << "\n";
+    }
+    return 0;
+}
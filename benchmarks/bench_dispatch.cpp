@@ -0,0 +1,95 @@
+#include "bench_util.hpp"
+#include "exchange_factory.hpp"
+#include "venue_registry.hpp"
+#include <random>
+#include <sstream>
+
+// Synthetic full-depth Coinbase level-2 response of roughly `target_bytes`
+static std::string makeFixture(size_t target_bytes) {
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<int> size_dist(1, 99999999);
+    std::ostringstream ss;
+    ss << "{\"bids\":[";
+    size_t half = target_bytes / 2;
+    size_t i = 0;
+    for (; static_cast<size_t>(ss.tellp()) < half; ++i) {
+        ss << (i ? "," : "") << "[\"" << 100000 - i * 0.01 << "\",\"0." << size_dist(rng) << "\",2]";
+    }
+    ss << "],\"asks\":[";
+    for (size_t j = 0; static_cast<size_t>(ss.tellp()) < target_bytes; ++j) {
+        ss << (j ? "," : "") << "[\"" << 100000.01 + j * 0.01 << "\",\"1." << size_dist(rng) << "\",1]";
+    }
+    ss << "],\"sequence\":1}";
+    return ss.str();
+}
+
+int main() {
+    std::cout << "=== Venue Dispatch Benchmark ===\n";
+    const uint64_t kIters = 1000000;
+    
+    // Per-poll bookkeeping: the aggregator asks every venue for its id and
+    // name several times a cycle
+    std::cout << "\nPer-venue metadata (id + name) across all venues:\n";
+    auto clients = ExchangeFactory::createFromConfig("");
+    venues::Registry registry;
+    registry.activate(venues::Registry::selectFromConfig(""));
+    
+    double virtual_meta = bench::nsPerOp([&] {
+        size_t sum = 0;
+        for (const auto& client : clients) {
+            sum += static_cast<size_t>(client->getExchangeId()) + client->getName().size();
+        }
+        bench::doNotOptimize(sum);
+    }, kIters);
+    double static_meta = bench::nsPerOp([&] {
+        size_t sum = 0;
+        for (size_t i = 0; i < registry.size(); ++i) {
+            sum += static_cast<size_t>(registry.id(i)) + std::char_traits<char>::length(registry.name(i));
+        }
+        bench::doNotOptimize(sum);
+    }, kIters);
+    bench::printRow("IExchangeClient virtual calls", virtual_meta);
+    bench::printRow("VenueRegistry slot lookup", static_meta, virtual_meta);
+    
+    // Per-level conversion: a function pointer call the optimiser cannot see
+    // through, versus the policy's converter inlined into the loop
+    std::cout << "\nLevel conversion, 2000 levels:\n";
+    nlohmann::json levels = nlohmann::json::array();
+    for (int i = 0; i < 2000; ++i) {
+        levels.push_back({std::to_string(50000 + i) + ".25", "0.12345678", 3});
+    }
+    book_parser::LevelConverter opaque = book_parser::arrayLevel;
+    bench::doNotOptimize(opaque);
+    std::vector<PriceLevel> out;
+    out.reserve(levels.size());
+    
+    double pointer_convert = bench::nsPerOp([&] {
+        out.clear();
+        for (const auto& level : levels) opaque(level, Exchange::COINBASE, out);
+        bench::doNotOptimize(out.data());
+    }, 2000);
+    double inline_convert = bench::nsPerOp([&] {
+        out.clear();
+        for (const auto& level : levels) venues::Coinbase::convertLevel(level, Exchange::COINBASE, out);
+        bench::doNotOptimize(out.data());
+    }, 2000);
+    bench::printRow("LevelConverter function pointer", pointer_convert);
+    bench::printRow("Coinbase::convertLevel inlined", inline_convert, pointer_convert);
+    
+    // End to end on a realistic full-depth book
+    std::string body = makeFixture(300 * 1024);
+    std::cout << "\nFull parse, " << body.size() / 1024 << " KB Coinbase book:\n";
+    double pointer_parse = bench::nsPerOp([&] {
+        OrderBookSnapshot s;
+        book_parser::parseBook(body, Exchange::COINBASE, opaque, s);
+        bench::doNotOptimize(s.bids.size());
+    }, 100);
+    double static_parse = bench::nsPerOp([&] {
+        OrderBookSnapshot s;
+        venues::VenueClient<venues::Coinbase>::parse(body, s);
+        bench::doNotOptimize(s.bids.size());
+    }, 100);
+    bench::printRow("parseBook + function pointer", pointer_parse);
+    bench::printRow("VenueClient<Coinbase>::parse", static_parse, pointer_parse);
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "bench_util.hpp"
+#include "mock_exchange.hpp"
+#include "order_book.hpp"
+#include "price_calculator.hpp"
+#include "venue_registry.hpp"
+#include <algorithm>
+#include <future>
+#include <unistd.h>
+
+// End-to-end load driver: the aggregator's fetch -> parse -> merge -> quote
+// cycle against a local MockExchangeServer, swept over venue count and
+// book depth. Each cycle polls every venue concurrently, as main() does
+// when budgets allow.
+
+struct LoadResult {
+    size_t cycles = 0;
+    double seconds = 0.0;
+    double p50_ms = 0.0;
+    double p99_ms = 0.0;
+    uint64_t failures = 0;
+};
+
+static LoadResult runLoad(size_t venue_count, size_t depth, double budget_seconds) {
+    const Exchange kVenues[] = {Exchange::COINBASE, Exchange::GEMINI, Exchange::BINANCE, Exchange::KRAKEN};
+    MockServerConfig config;
+    for (size_t i = 0; i < venue_count; ++i) {
+        MockVenueConfig venue;
+        venue.venue = kVenues[i];
+        venue.depth = depth;
+        venue.latency = {1.0, 5.0};
+        venue.error_rate = 0.01;
+        venue.churn = 0.05;
+        config.venues.push_back(venue);
+    }
+    MockExchangeServer server(config);
+    
+    std::string path = "/tmp/bench_end_to_end_" + std::to_string(::getpid()) + ".json";
+    server.writeConfig(path);
+    venues::Registry registry;
+    registry.activate(venues::Registry::selectFromConfig(path));
+    std::remove(path.c_str());
+    
+    OrderBook aggregated;
+    LoadResult result;
+    std::vector<double> latencies;
+    std::vector<std::future<OrderBookSnapshot>> in_flight(registry.size());
+    auto start = std::chrono::steady_clock::now();
+    
+    while (true) {
+        auto cycle_start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < registry.size(); ++i) {
+            in_flight[i] = std::async(std::launch::async, [&registry, i] { return registry.fetch(i); });
+        }
+        for (size_t i = 0; i < registry.size(); ++i) {
+            OrderBookSnapshot snapshot = in_flight[i].get();
+            if (!snapshot.success) {
+                ++result.failures;
+            } else if (!snapshot.unchanged) {
+                aggregated.replaceExchange(registry.id(i), snapshot.bids, snapshot.asks);
+            }
+        }
+        auto quote = PriceCalculator::calculateBuyPrice(aggregated.getAsks(), 10 * QUANTITY_SCALE);
+        bench::doNotOptimize(quote.total_cost);
+        auto cycle_end = std::chrono::steady_clock::now();
+    
+        latencies.push_back(std::chrono::duration<double, std::milli>(cycle_end - cycle_start).count());
+        result.seconds = std::chrono::duration<double>(cycle_end - start).count();
+        if (result.seconds >= budget_seconds && latencies.size() >= 20) break;
+    }
+    
+    std::sort(latencies.begin(), latencies.end());
+    result.cycles = latencies.size();
+    result.p50_ms = latencies[latencies.size() / 2];
+    result.p99_ms = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+    return result;
+}
+
+int main() {
+    std::cout << "=== End-to-End Load Benchmark (local mock exchange) ===\n";
+    std::cout << "Mock latency median 1 ms / p99 5 ms, 1% injected 503s, 5% level churn per request\n\n";
+    std::cout << std::left << std::setw(8) << "venues" << std::setw(8) << "depth"
+              << std::right << std::setw(10) << "cycles/s" << std::setw(12) << "p50 ms"
+              << std::setw(12) << "p99 ms" << std::setw(10) << "failed" << "\n";
+    
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    for (size_t depth : {100u, 1000u, 5000u}) {
+        for (size_t venues : {1u, 2u, 4u}) {
+            LoadResult r = runLoad(venues, depth, 1.5);
+            std::cout << std::left << std::setw(8) << venues << std::setw(8) << depth
+                      << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(10) << r.cycles / r.seconds
+                      << std::setprecision(2) << std::setw(12) << r.p50_ms
+                      << std::setw(12) << r.p99_ms << std::setw(10) << r.failures << "\n";
+        }
+    }
+    curl_global_cleanup();
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include "bench_util.hpp"
+#include "book_parser.hpp"
+#include "http_client.hpp"
+#include "price_calculator.hpp"
+#include <stdexcept>
+
+// The pre-ErrorCode snapshot: failures described by a heap string
+struct LegacySnapshot {
+    std::vector<PriceLevel> bids;
+    std::vector<PriceLevel> asks;
+    bool success = false;
+    std::string error;
+};
+
+// Old transport path: HTTPClient threw, the client caught and concatenated
+[[gnu::noinline]] static void legacyTransportFailure(LegacySnapshot& snapshot) {
+    try {
+        throw std::runtime_error(std::string("CURL error: ") +
+                                 curl_easy_strerror(CURLE_COULDNT_RESOLVE_HOST));
+    } catch (const std::exception& e) {
+        snapshot.success = false;
+        snapshot.error = std::string("Coinbase fetch error: ") + e.what();
+    }
+}
+
+[[gnu::noinline]] static Result<FetchOutcome> transportFailure() {
+    return Result<FetchOutcome>::failure(ErrorCode::DNS_FAILURE, CURLE_COULDNT_RESOLVE_HOST);
+}
+
+// Old parse path: json::parse threw on the venue's HTML error page
+[[gnu::noinline]] static void legacyParseFailure(const std::string& body, LegacySnapshot& snapshot) {
+    try {
+        auto j = nlohmann::json::parse(body);
+        bench::doNotOptimize(j);
+        snapshot.success = true;
+    } catch (const std::exception& e) {
+        snapshot.success = false;
+        snapshot.error = std::string("Coinbase parse error: ") + e.what();
+    }
+}
+
+// Old level path: std::stod threw on a non-numeric field
+[[gnu::noinline]] static void legacyLevelFailure(const nlohmann::json& level, LegacySnapshot& snapshot) {
+    try {
+        double price = std::stod(level[0].get<std::string>());
+        bench::doNotOptimize(price);
+    } catch (const std::exception& e) {
+        snapshot.success = false;
+        snapshot.error = std::string("Coinbase parse error: ") + e.what();
+    }
+}
+
+int main() {
+    std::cout << "=== Outage Error Path Benchmark ===\n";
+    const uint64_t kIters = 200000;
+    
+    std::cout << "\nVenue unreachable (DNS failure), per attempt:\n";
+    double legacy_transport = bench::nsPerOp([] {
+        LegacySnapshot s;
+        legacyTransportFailure(s);
+        bench::doNotOptimize(s.error.size());
+    }, kIters);
+    double transport = bench::nsPerOp([] {
+        OrderBookSnapshot s;
+        auto fetched = transportFailure();
+        if (!fetched) s.fail(fetched.error(), fetched.detail());
+        bench::doNotOptimize(s.error);
+    }, kIters);
+    bench::printRow("throw + catch + string concat", legacy_transport);
+    bench::printRow("Result<FetchOutcome> -> ErrorCode", transport, legacy_transport);
+    
+    std::cout << "\nVenue returns an HTML error page:\n";
+    const std::string html = "<html><body><h1>503 Service Unavailable</h1></body></html>";
+    double legacy_parse = bench::nsPerOp([&] {
+        LegacySnapshot s;
+        legacyParseFailure(html, s);
+        bench::doNotOptimize(s.error.size());
+    }, kIters);
+    double parse = bench::nsPerOp([&] {
+        OrderBookSnapshot s;
+        ErrorCode error = book_parser::parseBook(html, Exchange::COINBASE, book_parser::arrayLevel, s);
+        if (error != ErrorCode::OK) s.fail(error);
+        bench::doNotOptimize(s.error);
+    }, kIters);
+    bench::printRow("json::parse throws + string concat", legacy_parse);
+    bench::printRow("sniff + no-throw parse -> ErrorCode", parse, legacy_parse);
+    
+    std::cout << "\nMalformed price level:\n";
+    const auto bad_level = nlohmann::json::parse(R"(["n/a", "1.0", 1])");
+    double legacy_level = bench::nsPerOp([&] {
+        LegacySnapshot s;
+        legacyLevelFailure(bad_level, s);
+        bench::doNotOptimize(s.error.size());
+    }, kIters);
+    double level = bench::nsPerOp([&] {
+        std::vector<PriceLevel> out;
+        bool ok = book_parser::arrayLevel(bad_level, Exchange::COINBASE, out);
+        bench::doNotOptimize(ok);
+    }, kIters);
+    bench::printRow("std::stod throws + string concat", legacy_level);
+    bench::printRow("strtod in place -> false", level, legacy_level);
+    
+    std::cout << "\nEmpty book quote:\n";
+    std::vector<PriceLevel> empty;
+    double quote = bench::nsPerOp([&] {
+        auto result = PriceCalculator::calculateBuyPrice(empty, QUANTITY_SCALE);
+        bench::doNotOptimize(result.error);
+    }, kIters);
+    bench::printRow("calculateBuyPrice -> NO_ASKS", quote);
+    
+    // For scale: a real failing request through libcurl (refused loopback port)
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    {
+        ConditionalFetcher fetcher("http://127.0.0.1:9/book");
+        std::string body;
+        double refused = bench::nsPerOp([&] {
+            auto fetched = fetcher.fetch(1000, body);
+            bench::doNotOptimize(fetched.error());
+        }, 200);
+        std::cout << "\nFor scale, a full request to a refused local port:\n";
+        bench::printRow("ConditionalFetcher::fetch (libcurl)", refused);
+    }
+    curl_global_cleanup();
+    return 0;
+}
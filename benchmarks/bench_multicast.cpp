@@ -0,0 +1,95 @@
+#include "bench_util.hpp"
+#include "book_multicast.hpp"
+#include <atomic>
+#include <random>
+#include <thread>
+#include <unistd.h>
+
+// Moves a few levels per step, like a busy venue between two polls
+static void churn(OrderBook& book, std::mt19937_64& rng, int changes) {
+    std::uniform_int_distribution<int> level(0, 999);
+    std::uniform_int_distribution<int64_t> size(1, 50);
+    for (int c = 0; c < changes; ++c) {
+        int i = level(rng);
+        Exchange ex = (i % 2) ? Exchange::GEMINI : Exchange::COINBASE;
+        book.setBidLevel(9999000 - i * 100, size(rng) * 1000000, ex);
+        book.setAskLevel(10001000 + i * 100, size(rng) * 1000000, ex);
+    }
+}
+
+int main() {
+    std::cout << "=== Book Multicast Benchmark ===\n";
+    std::mt19937_64 rng(5);
+    OrderBook book;
+    churn(book, rng, 4000);
+    
+    // Encode cost alone: diff + packetise into an in-process sink
+    {
+        uint64_t bytes = 0;
+        BookMulticastPublisher publisher([&bytes](const uint8_t*, size_t len) { bytes += len; });
+        double snapshot_ns = bench::nsPerOp([&] { publisher.publishSnapshot(book); }, 200);
+        double delta_ns = bench::nsPerOp([&] {
+            churn(book, rng, 30);
+            publisher.publishDelta(book);
+        }, 2000);
+        bench::doNotOptimize(bytes);
+        std::cout << "  Book: " << book.bidDepth() + book.askDepth() << " levels\n";
+        bench::printRow("publishSnapshot (full book)", snapshot_ns);
+        bench::printRow("churn 60 levels + publishDelta", delta_ns);
+    }
+    
+    // Loopback fan-out: one publisher, several receivers in their own threads
+    MulticastEndpoint endpoint;
+    endpoint.port = static_cast<uint16_t>(32000 + ::getpid() % 20000);
+    endpoint.interface_addr = "127.0.0.1";
+    
+    const int kReceivers = 4;
+    const int kSteps = 5000;
+    
+    std::unique_ptr<BookMulticastPublisher> publisher;
+    std::vector<std::unique_ptr<BookMulticastReceiver>> receivers;
+    try {
+        publisher = std::make_unique<BookMulticastPublisher>(endpoint);
+        for (int r = 0; r < kReceivers; ++r) {
+            receivers.push_back(std::make_unique<BookMulticastReceiver>(endpoint));
+        }
+    } catch (const std::exception& e) {
+        std::cout << "  Fan-out skipped: " << e.what() << "\n";
+        return 0;
+    }
+    
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+    for (auto& receiver : receivers) {
+        threads.emplace_back([&done, rx = receiver.get()] {
+            while (!done.load(std::memory_order_relaxed)) rx->poll(10);
+            rx->poll(50);  // Drain
+        });
+    }
+    
+    size_t levels_sent = 0;
+    auto start = std::chrono::steady_clock::now();
+    publisher->publishSnapshot(book);
+    for (int step = 0; step < kSteps; ++step) {
+        churn(book, rng, 30);
+        levels_sent += publisher->publishDelta(book);
+        if (step % 500 == 499) publisher->publishSnapshot(book);
+    }
+    publisher->publishSnapshot(book);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    done = true;
+    for (auto& t : threads) t.join();
+    
+    std::cout << "  Fan-out: " << kReceivers << " receivers, " << publisher->packetsSent()
+              << " packets, " << publisher->bytesSent() / 1024 << " KB\n";
+    std::cout << "  Publish rate: " << std::fixed << std::setprecision(0)
+              << publisher->packetsSent() / secs << " packets/s, "
+              << levels_sent / secs << " delta levels/s\n";
+    for (int r = 0; r < kReceivers; ++r) {
+        const auto& rx = *receivers[r];
+        std::cout << "  Receiver " << r << ": " << rx.packetsReceived() << " packets, "
+                  << rx.gaps() << " gaps, " << (rx.synced() ? "synced" : "NOT synced") << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include "bench_util.hpp"
+#include "perf_counters.hpp"
+#include "execution_walker.hpp"
+#include "order_book.hpp"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+// Book storage layout: the multimap-of-PriceLevel book this replaced against
+// the column book on 4 KB and on 2 MB pages, with cache and TLB miss
+// counters per operation.
+
+// The previous OrderBook storage: one heap node per level, same locking
+struct MultimapBook {
+    std::multimap<Price, PriceLevel> asks;
+    mutable std::shared_mutex mutex;
+    std::atomic<uint64_t> version{0};
+
+    std::vector<PriceLevel> getAsks() const {
+        std::shared_lock lock(mutex);
+        std::vector<PriceLevel> result;
+        result.reserve(asks.size());
+        for (const auto& [price, level] : asks) result.push_back(level);
+        return result;
+    }
+
+    void replaceExchange(Exchange exchange, const std::vector<PriceLevel>& levels) {
+        std::unique_lock lock(mutex);
+        version.fetch_add(1, std::memory_order_release);
+        for (auto it = asks.begin(); it != asks.end();) {
+            it = it->second.exchange == exchange ? asks.erase(it) : std::next(it);
+        }
+        for (const auto& level : levels) asks.emplace(level.price, level);
+    }
+
+    void setLevel(Price price, Quantity size, Exchange exchange) {
+        std::unique_lock lock(mutex);
+        version.fetch_add(1, std::memory_order_release);
+        auto [first, last] = asks.equal_range(price);
+        for (auto it = first; it != last; ++it) {
+            if (it->second.exchange == exchange) {
+                if (size == 0) asks.erase(it); else it->second.size = size;
+                return;
+            }
+        }
+        if (size != 0) asks.emplace_hint(last, price, PriceLevel(price, size, exchange));
+    }
+};
+
+static const Exchange kVenues[] = {Exchange::COINBASE, Exchange::GEMINI, Exchange::BINANCE, Exchange::KRAKEN};
+
+static std::vector<PriceLevel> venueLevels(std::mt19937_64& rng, size_t count, size_t venue) {
+    std::uniform_int_distribution<Quantity> size_dist(QUANTITY_SCALE / 100, QUANTITY_SCALE);
+    std::vector<PriceLevel> levels;
+    for (size_t i = 0; i < count; ++i) {
+        levels.emplace_back(10000000 + static_cast<Price>(i * 4 + venue) * 25, size_dist(rng), kVenues[venue]);
+    }
+    return levels;
+}
+
+int main() {
+    std::cout << "=== Order Book Layout Benchmark ===\n";
+    bench::PerfCounters counters;
+    if (!counters.available()) {
+        std::cout << "perf_event_open unavailable (container or perf_event_paranoid); miss columns show n/a\n";
+    }
+
+    for (size_t depth : {1000u, 10000u, 100000u}) {
+        std::mt19937_64 rng(depth);
+        std::vector<std::vector<PriceLevel>> venues;
+        for (size_t v = 0; v < 4; ++v) venues.push_back(venueLevels(rng, depth / 4, v));
+
+        // Venue snapshots arrive one at a time between other allocations
+        // (response bodies, parse buffers), which scatters multimap nodes
+        // the way a long-running process does
+        MultimapBook legacy;
+        std::vector<std::unique_ptr<std::string>> noise;
+        for (size_t v = 0; v < 4; ++v) {
+            for (const auto& level : venues[v]) {
+                legacy.setLevel(level.price, level.size, level.exchange);
+                noise.push_back(std::make_unique<std::string>(64 + rng() % 512, 'x'));
+            }
+        }
+        for (size_t i = 0; i < depth; ++i) {
+            const auto& level = venues[i % 4][rng() % venues[i % 4].size()];
+            legacy.setLevel(level.price, 0, level.exchange);
+            noise[rng() % noise.size()] = std::make_unique<std::string>(64 + rng() % 512, 'y');
+            legacy.setLevel(level.price, level.size, level.exchange);
+        }
+
+        OrderBook small_pages(HugePageArena::Backing::SMALL_PAGES);
+        OrderBook huge_pages;
+        for (size_t v = 0; v < 4; ++v) {
+            small_pages.replaceExchange(kVenues[v], {}, venues[v]);
+            huge_pages.replaceExchange(kVenues[v], {}, venues[v]);
+        }
+
+        Quantity total = 0;
+        for (const auto& level : legacy.getAsks()) total += level.size;
+        const Quantity qty = total / 10 * 9;
+        uint64_t iters = depth <= 1000 ? 20000 : depth <= 10000 ? 2000 : 200;
+        using Walker = execution::ExecutionWalker<execution::AskSide>;
+        auto walkInPlace = [qty](const BookSideView& view) {
+            return Walker::walkColumns(view.prices, view.sizes, view.count, qty);
+        };
+
+        std::cout << "\nDepth " << depth << " asks, quote 90% of book (" << HugePageArena::backingName(huge_pages.backing())
+                  << " for the huge-page book):\n";
+        bench::printCountedHeader();
+        double base = 0.0;
+        bench::printCounted("multimap, copy out + walk", [&] {
+            auto asks = legacy.getAsks();
+            bench::doNotOptimize(Walker::walkSorted(asks.data(), asks.size(), qty));
+        }, iters, counters, 0.0, &base);
+        bench::printCounted("columns, copy out + walk", [&] {
+            auto asks = huge_pages.getAsks();
+            bench::doNotOptimize(Walker::walkSorted(asks.data(), asks.size(), qty));
+        }, iters, counters, base);
+        bench::printCounted("columns in place, 4 KB pages", [&] {
+            bench::doNotOptimize(small_pages.readAsks(walkInPlace));
+        }, iters, counters, base);
+        bench::printCounted("columns in place, huge pages", [&] {
+            bench::doNotOptimize(huge_pages.readAsks(walkInPlace));
+        }, iters, counters, base);
+
+        std::cout << "Depth " << depth << " asks, replace one venue's snapshot:\n";
+        size_t round = 0;
+        bench::printCounted("multimap", [&] {
+            legacy.replaceExchange(kVenues[round % 4], venues[round % 4]);
+            ++round;
+        }, iters / 10 + 1, counters, 0.0, &base);
+        bench::printCounted("columns, huge pages", [&] {
+            huge_pages.replaceExchange(kVenues[round % 4], {}, venues[round % 4]);
+            ++round;
+        }, iters / 10 + 1, counters, base);
+
+        // Delta feeds mostly touch the first few levels
+        std::cout << "Depth " << depth << " asks, add + remove a level near the top:\n";
+        const Price near_top = venues[0][3].price + 1;
+        bench::printCounted("multimap", [&] {
+            legacy.setLevel(near_top, QUANTITY_SCALE, Exchange::KRAKEN);
+            legacy.setLevel(near_top, 0, Exchange::KRAKEN);
+        }, iters * 10, counters, 0.0, &base);
+        bench::printCounted("columns, huge pages", [&] {
+            huge_pages.setAskLevel(near_top, QUANTITY_SCALE, Exchange::KRAKEN);
+            huge_pages.setAskLevel(near_top, 0, Exchange::KRAKEN);
+        }, iters * 10, counters, base);
+    }
+    return 0;
+}
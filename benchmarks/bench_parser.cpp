@@ -0,0 +1,50 @@
+#include "bench_util.hpp"
+#include "book_parser.hpp"
+#include "work_stealing_pool.hpp"
+#include <random>
+#include <sstream>
+
+// Synthetic full-depth Coinbase level-2 response of roughly `target_bytes`
+static std::string makeFixture(size_t target_bytes) {
+    std::mt19937_64 rng(99);
+    std::uniform_int_distribution<int> size_dist(1, 99999999);
+    std::ostringstream ss;
+    ss << "{\"bids\":[";
+    size_t half = target_bytes / 2;
+    size_t i = 0;
+    for (; static_cast<size_t>(ss.tellp()) < half; ++i) {
+        ss << (i ? "," : "") << "[\"" << 100000 - i * 0.01 << "\",\"0." << size_dist(rng) << "\",2]";
+    }
+    ss << "],\"asks\":[";
+    for (size_t j = 0; static_cast<size_t>(ss.tellp()) < target_bytes; ++j) {
+        ss << (j ? "," : "") << "[\"" << 100000.01 + j * 0.01 << "\",\"1." << size_dist(rng) << "\",1]";
+    }
+    ss << "],\"sequence\":1}";
+    return ss.str();
+}
+
+int main() {
+    std::cout << "=== Book Parser Benchmark ===\n";
+    std::cout << "Workers: " << WorkStealingPool::instance().workerCount() << " (+ caller)\n";
+    
+    for (size_t bytes : {300u * 1024u, 5u * 1024u * 1024u}) {
+        std::string body = makeFixture(bytes);
+        std::cout << "\nFixture " << body.size() / 1024 << " KB:\n";
+        uint64_t iters = bytes > 1024 * 1024 ? 10 : 100;
+        
+        double serial = bench::nsPerOp([&] {
+            OrderBookSnapshot s;
+            book_parser::parseBookSerial(body, Exchange::COINBASE, book_parser::arrayLevel, s);
+            bench::doNotOptimize(s.bids.size());
+        }, iters);
+        bench::printRow("serial json::parse", serial);
+        
+        double parallel = bench::nsPerOp([&] {
+            OrderBookSnapshot s;
+            book_parser::parseBook(body, Exchange::COINBASE, book_parser::arrayLevel, s);
+            bench::doNotOptimize(s.bids.size());
+        }, iters);
+        bench::printRow("chunked on work-stealing pool", parallel, serial);
+    }
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include "bench_util.hpp"
+#include "execution_walker.hpp"
+#include "price_calculator.hpp"
+#include "quote_cache.hpp"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+// The pre-walker implementation: copy, sort, branchy per-level loop
+static ExecutionResult legacyBuy(const std::vector<PriceLevel>& asks, Quantity quantity) {
+    ExecutionResult result{0, 0, false, ErrorCode::OK};
+    std::vector<PriceLevel> sorted_asks = asks;
+    std::sort(sorted_asks.begin(), sorted_asks.end(),
+        [](const PriceLevel& a, const PriceLevel& b) { return a.price < b.price; });
+    Quantity remaining = quantity;
+    for (const auto& ask : sorted_asks) {
+        if (remaining <= 0) break;
+        Quantity fill_amount = std::min(remaining, ask.size);
+        result.total_cost += (ask.price * fill_amount) / QUANTITY_SCALE;
+        result.quantity_filled += fill_amount;
+        remaining -= fill_amount;
+    }
+    result.fully_filled = (remaining == 0);
+    return result;
+}
+
+// What the execution system did before routing output: quote, then walk
+// again to split the fill per venue
+static std::array<Quantity, kRoutedVenues> legacyAllocation(const std::vector<PriceLevel>& asks,
+                                                             Quantity quantity) {
+    auto quote = PriceCalculator::calculateBuyPrice(asks, quantity);
+    bench::doNotOptimize(quote);
+    std::array<Quantity, kRoutedVenues> split{};
+    Quantity remaining = quantity;
+    for (const auto& ask : asks) {
+        if (remaining <= 0) break;
+        Quantity fill = std::min(remaining, ask.size);
+        split[static_cast<size_t>(ask.exchange)] += fill;
+        remaining -= fill;
+    }
+    return split;
+}
+
+// walkSorted without the int64 overflow proof: every sum goes through the
+// 128-bit accumulator
+static int64_t alwaysWideCost(const std::vector<PriceLevel>& asks, Quantity quantity) {
+    auto cross = execution::findCrossing<execution::kPriceLevelStride>(&asks[0].size, asks.size(), quantity);
+    fixed_point::WideNotional wide;
+    for (size_t i = 0; i < cross.index; ++i) wide.add(asks[i].price, asks[i].size);
+    if (cross.index < asks.size()) wide.add(asks[cross.index].price, quantity - cross.consumed_before);
+    return wide.cents();
+}
+
+static std::vector<PriceLevel> makeAsks(size_t depth) {
+    std::mt19937_64 rng(1234);
+    std::uniform_int_distribution<Quantity> size_dist(QUANTITY_SCALE / 100, QUANTITY_SCALE);
+    std::vector<PriceLevel> asks;
+    asks.reserve(depth);
+    for (size_t i = 0; i < depth; ++i) {
+        asks.emplace_back(10000000 + static_cast<Price>(i) * 25, size_dist(rng),
+                          i % 2 ? Exchange::GEMINI : Exchange::COINBASE);
+    }
+    return asks;
+}
+
+int main() {
+    std::cout << "=== Price Calculator Benchmark ===\n";
+
+    for (size_t depth : {50u, 1000u, 10000u}) {
+        auto asks = makeAsks(depth);
+        OrderBook book;
+        book.mergeAsks(asks);
+        QuoteCache cache(book);
+        Quantity total = 0;
+        for (const auto& a : asks) total += a.size;
+
+        uint64_t iters = depth <= 50 ? 2000000 : depth <= 1000 ? 200000 : 20000;
+
+        struct Case { const char* label; Quantity qty; };
+        for (Case c : {Case{"10 BTC", 10 * QUANTITY_SCALE}, Case{"90% of book", total / 10 * 9}}) {
+            std::cout << "\nDepth " << depth << ", " << c.label << ":\n";
+
+            double legacy = bench::nsPerOp([&] {
+                bench::doNotOptimize(legacyBuy(asks, c.qty));
+            }, iters);
+            bench::printRow("legacy copy+sort+scalar", legacy);
+
+            double calc = bench::nsPerOp([&] {
+                bench::doNotOptimize(PriceCalculator::calculateBuyPrice(asks, c.qty));
+            }, iters);
+            bench::printRow("PriceCalculator (walker)", calc, legacy);
+
+            double sorted = bench::nsPerOp([&] {
+                bench::doNotOptimize(execution::ExecutionWalker<execution::AskSide>::walkSorted(
+                    asks.data(), asks.size(), c.qty));
+            }, iters);
+            bench::printRow("walkSorted (pre-ordered book)", sorted, legacy);
+            
+            double wide = bench::nsPerOp([&] {
+                bench::doNotOptimize(alwaysWideCost(asks, c.qty));
+            }, iters);
+            bench::printRow("walkSorted, 128-bit sum always", wide, sorted);
+
+            double scalar_scan = bench::nsPerOp([&] {
+                bench::doNotOptimize(execution::findCrossingScalar<execution::kPriceLevelStride>(
+                    &asks[0].size, asks.size(), c.qty));
+            }, iters);
+            bench::printRow("crossing scan, scalar", scalar_scan);
+
+            double simd_scan = bench::nsPerOp([&] {
+                bench::doNotOptimize(execution::findCrossing<execution::kPriceLevelStride>(
+                    &asks[0].size, asks.size(), c.qty));
+            }, iters);
+            bench::printRow("crossing scan, SIMD", simd_scan, scalar_scan);
+
+            double uncached = bench::nsPerOp([&] {
+                bench::doNotOptimize(PriceCalculator::calculateBuyPrice(book.getAsks(), c.qty));
+            }, iters);
+            bench::printRow("quote from OrderBook, uncached", uncached);
+
+            double cached = bench::nsPerOp([&] {
+                bench::doNotOptimize(cache.quote(QuoteSide::BUY, c.qty));
+            }, iters);
+            bench::printRow("quote from OrderBook, QuoteCache hit", cached, uncached);
+            
+            double rewalk = bench::nsPerOp([&] {
+                bench::doNotOptimize(legacyAllocation(asks, c.qty));
+            }, iters);
+            bench::printRow("quote + re-walk for venue split", rewalk);
+            
+            double routed = bench::nsPerOp([&] {
+                bench::doNotOptimize(PriceCalculator::routeBuy(asks, c.qty));
+            }, iters);
+            bench::printRow("routeBuy (split in the same walk)", routed, rewalk);
+            
+            RoutingRules fees;
+            fees[Exchange::COINBASE].taker_fee_ppm = 6000;
+            fees[Exchange::GEMINI].taker_fee_ppm = 4000;
+            double fee_aware = bench::nsPerOp([&] {
+                bench::doNotOptimize(PriceCalculator::routeBuy(asks, c.qty, fees));
+            }, iters);
+            bench::printRow("routeBuy, unequal fees (venue merge)", fee_aware, rewalk);
+        }
+        
+        // Whale book: 10,000x the sizes, past what int64 can sum
+        std::vector<PriceLevel> whale = asks;
+        for (auto& level : whale) level.size *= 10000;
+        std::cout << "\nDepth " << depth << ", 90% of a 10,000x book (128-bit path):\n";
+        double whale_ns = bench::nsPerOp([&] {
+            bench::doNotOptimize(execution::ExecutionWalker<execution::AskSide>::walkSorted(
+                whale.data(), whale.size(), total / 10 * 9 * 10000));
+        }, iters);
+        bench::printRow("walkSorted", whale_ns);
+        
+        // A ladder of order sizes, as a pricing screen would request
+        std::vector<Quantity> ladder;
+        for (int i = 1; i <= 32; ++i) ladder.push_back(total / 40 * i);
+        std::vector<RoutedExecution> out;
+        std::cout << "\nDepth " << depth << ", 32-size ladder:\n";
+        double singles = bench::nsPerOp([&] {
+            for (Quantity q : ladder) bench::doNotOptimize(PriceCalculator::routeBuy(asks, q));
+        }, iters / 16 + 1);
+        bench::printRow("32 x routeBuy", singles);
+        double batch = bench::nsPerOp([&] {
+            PriceCalculator::routeBuyBatch(asks, ladder, RoutingRules{}, out);
+            bench::doNotOptimize(out.data());
+        }, iters / 16 + 1);
+        bench::printRow("routeBuyBatch (one walk)", batch, singles);
+    }
+    return 0;
+}
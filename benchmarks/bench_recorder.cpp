@@ -0,0 +1,68 @@
+#include "bench_util.hpp"
+#include "book_recorder.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <sys/stat.h>
+#include <unistd.h>
+
+int main() {
+    std::cout << "=== Book Recorder Benchmark ===\n";
+    const std::string path = "/tmp/bench_recorder_" + std::to_string(::getpid()) + ".obkrec";
+    const size_t kRows = 2000000;
+    
+    RecorderLayout layout;
+    layout.venues = {Exchange::COINBASE, Exchange::GEMINI, Exchange::BINANCE, Exchange::KRAKEN};
+    const size_t columns = layout.columns();
+    
+    // Random-walk rows resembling a quiet market sampled every 2 s
+    std::mt19937_64 rng(17);
+    std::uniform_int_distribution<int64_t> tick(-300, 300);
+    std::vector<int64_t> row(columns, 10000000);
+    
+    auto start = std::chrono::steady_clock::now();
+    {
+        BookRecorder recorder(path, layout);
+        for (size_t r = 0; r < kRows; ++r) {
+            row[0] = 1700000000000000 + static_cast<int64_t>(r) * 2000000;
+            for (size_t c = 1; c < columns; ++c) row[c] += tick(rng);
+            recorder.record(row.data());
+        }
+    }
+    double write_ns = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count() / kRows;
+    
+    struct stat st;
+    ::stat(path.c_str(), &st);
+    std::cout << "  Rows: " << kRows << ", columns: " << columns << "\n";
+    std::cout << "  File: " << st.st_size / 1024 << " KB (" << std::fixed << std::setprecision(2)
+              << static_cast<double>(st.st_size) / kRows << " bytes/row vs "
+              << columns * sizeof(int64_t) << " raw)\n";
+    bench::printRow("record() incl. background encode, per row", write_ns);
+    
+    RecordingReader reader(path);
+    int64_t checksum = 0;
+    start = std::chrono::steady_clock::now();
+    uint64_t rows = reader.forEachRow([&](const int64_t* values, size_t n, size_t r) {
+        checksum += values[n + r];
+    });
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    bench::doNotOptimize(checksum);
+    std::cout << "  Full scan:   " << std::setprecision(1) << rows / secs / 1e6 << " M rows/s\n";
+    
+    reader.rewind();
+    std::vector<int64_t> column;
+    size_t n = 0;
+    rows = 0;
+    start = std::chrono::steady_clock::now();
+    while (reader.nextBlockColumn(1, column, n)) {
+        for (size_t r = 0; r < n; ++r) checksum += column[r];
+        rows += n;
+    }
+    secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    bench::doNotOptimize(checksum);
+    std::cout << "  One column:  " << rows / secs / 1e6 << " M rows/s\n";
+    
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace bench {
+
+template<typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Runs func() `iterations` times after a short warm-up, returns ns per call
+template<typename Func>
+double nsPerOp(Func&& func, uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations / 10 + 1; ++i) func();
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+inline void printRow(const std::string& name, double ns, double baseline_ns = 0.0) {
+    std::cout << "  " << std::left << std::setw(44) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(1) << ns << " ns";
+    if (baseline_ns > 0.0) {
+        std::cout << "  (" << std::setprecision(2) << baseline_ns / ns << "x)";
+    }
+    std::cout << "\n";
+}
+
+}  // namespace bench
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+// User-space hardware counters for this thread via perf_event_open. Events
+// the kernel, CPU or container refuses read as -1 and print as "n/a"
+// (perf_event_paranoid <= 2 is enough for these).
+class PerfCounters {
+public:
+    enum Event { CACHE_MISSES, L1D_READ_MISSES, DTLB_READ_MISSES, EVENT_COUNT };
+
+    PerfCounters() {
+#if defined(__linux__)
+        open(CACHE_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        open(L1D_READ_MISSES, PERF_TYPE_HW_CACHE, cacheEvent(PERF_COUNT_HW_CACHE_L1D));
+        open(DTLB_READ_MISSES, PERF_TYPE_HW_CACHE, cacheEvent(PERF_COUNT_HW_CACHE_DTLB));
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (int fd : fds_) {
+            if (fd >= 0) ::close(fd);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const noexcept {
+        for (int fd : fds_) {
+            if (fd >= 0) return true;
+        }
+        return false;
+    }
+
+    void start() noexcept {
+#if defined(__linux__)
+        for (int fd : fds_) {
+            if (fd < 0) continue;
+            ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void stop() noexcept {
+        for (int i = 0; i < EVENT_COUNT; ++i) {
+            values_[i] = -1;
+#if defined(__linux__)
+            if (fds_[i] < 0) continue;
+            ::ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t count = 0;
+            if (::read(fds_[i], &count, sizeof(count)) == sizeof(count)) {
+                values_[i] = static_cast<int64_t>(count);
+            }
+#endif
+        }
+    }
+
+    int64_t value(Event event) const noexcept { return values_[event]; }
+
+private:
+#if defined(__linux__)
+    static uint64_t cacheEvent(uint64_t cache) noexcept {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+
+    void open(Event event, uint32_t type, uint64_t config) noexcept {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fds_[event] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+    int fds_[EVENT_COUNT] = {-1, -1, -1};
+    int64_t values_[EVENT_COUNT] = {-1, -1, -1};
+};
+
+// Runs func() `iterations` times under the counters; prints ns/op and
+// misses/op in one row
+template<typename Func>
+void printCounted(const std::string& name, Func&& func, uint64_t iterations, PerfCounters& counters,
+                  double baseline_ns = 0.0, double* ns_out = nullptr) {
+    for (uint64_t i = 0; i < iterations / 10 + 1; ++i) func();
+    counters.start();
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) func();
+    auto end = std::chrono::steady_clock::now();
+    counters.stop();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    if (ns_out) *ns_out = ns;
+
+    std::cout << "  " << std::left << std::setw(36) << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(12) << ns;
+    for (int e = 0; e < PerfCounters::EVENT_COUNT; ++e) {
+        int64_t count = counters.value(static_cast<PerfCounters::Event>(e));
+        if (count < 0) {
+            std::cout << std::setw(12) << "n/a";
+        } else {
+            std::cout << std::setw(12) << std::setprecision(1) << static_cast<double>(count) / iterations;
+        }
+    }
+    if (baseline_ns > 0.0) {
+        std::cout << "  (" << std::setprecision(2) << baseline_ns / ns << "x)";
+    }
+    std::cout << "\n";
+}
+
+inline void printCountedHeader() {
+    std::cout << "  " << std::left << std::setw(36) << "" << std::right << std::setw(12) << "ns/op"
+              << std::setw(12) << "LLC miss" << std::setw(12) << "L1D miss" << std::setw(12) << "dTLB miss" << "\n";
+}
+
+}  // namespace bench
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "execution_walker.hpp"
+#include "order_book.hpp"
+#include "price_calculator.hpp"
+#include "types.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Bands and sizes to report; the defaults match RecorderLayout's
+struct AnalyticsLayout {
+    std::vector<int32_t> depth_bps{5, 10, 50};
+    std::vector<Quantity> vwap_sizes{1 * QUANTITY_SCALE, 5 * QUANTITY_SCALE, 10 * QUANTITY_SCALE};
+};
+
+// Liquidity figures for the aggregated book after one mutation
+struct LiquiditySnapshot {
+    static constexpr size_t kMaxBands = 8;
+    
+    struct DepthBand {
+        int32_t bps = 0;
+        Quantity bid_depth = 0;  // Satoshis bid at or above mid - band
+        Quantity ask_depth = 0;  // Satoshis offered at or below mid + band
+    
+        // (bid - ask) / (bid + ask), from -1 (all asks) to 1; 0 when empty
+        [[nodiscard]] double imbalance() const noexcept {
+            Quantity total = bid_depth + ask_depth;
+            return total == 0 ? 0.0 : static_cast<double>(bid_depth - ask_depth) / static_cast<double>(total);
+        }
+    };
+    
+    struct VwapBand {
+        Quantity size = 0;
+        ExecutionResult buy{0, 0, false, ErrorCode::NO_ASKS};   // As PriceCalculator quotes `size`
+        ExecutionResult sell{0, 0, false, ErrorCode::NO_BIDS};
+    
+        // Average fill price in cents per BTC; 0 unless fully filled
+        [[nodiscard]] static double vwap(const ExecutionResult& result) noexcept {
+            return result.fully_filled && result.quantity_filled > 0
+                ? static_cast<double>(result.total_cost) * QUANTITY_SCALE / static_cast<double>(result.quantity_filled)
+                : 0.0;
+        }
+    };
+    
+    uint64_t sequence = 0;  // Book mutations seen so far
+    
+    // Best prices across venues; sizes are summed over venues at that price
+    // and the venue is the first one to quote it
+    Price best_bid = 0;
+    Quantity best_bid_size = 0;
+    Exchange best_bid_venue = Exchange::UNKNOWN;
+    Price best_ask = 0;
+    Quantity best_ask_size = 0;
+    Exchange best_ask_venue = Exchange::UNKNOWN;
+    
+    // Spread, mid and bands are only set when both sides have levels
+    bool two_sided = false;
+    Price mid = 0;          // (best_bid + best_ask) / 2, truncated like the recorder
+    Price spread = 0;       // best_ask - best_bid; negative when venues cross
+    double spread_bps = 0.0;
+    
+    size_t band_count = 0;
+    std::array<DepthBand, kMaxBands> bands{};
+    size_t vwap_count = 0;
+    std::array<VwapBand, kMaxBands> vwaps{};
+};
+
+// Incrementally maintained liquidity analytics for one OrderBook. Each side
+// keeps two Fenwick trees over a window of one-cent ticks anchored near the
+// touch: size per tick, and size times distance from the lowest price.
+// A level change is two O(log window) updates, and the bands and VWAPs are
+// prefix sums and one descent each, so an update costs the same at 1k
+// levels as at 100k. Snapshot reads are a copy under a mutex.
+//
+// The window re-anchors (an O(window + levels) rebuild) when the touch
+// moves more than a quarter of it; a band or size that reaches past the
+// window falls back to the columns, which is exact but not O(1).
+class BookAnalytics : public BookListener {
+public:
+    static constexpr size_t kDefaultWindowTicks = size_t{1} << 18;  // $2,621 of one-cent ticks
+    
+    // Attaches to `book`, which must outlive this. The window is rounded up
+    // to a power of two; up to kMaxBands bands and sizes.
+    explicit BookAnalytics(OrderBook& book, AnalyticsLayout layout = {},
+                           size_t window_ticks = kDefaultWindowTicks);
+    ~BookAnalytics() override;
+    
+    BookAnalytics(const BookAnalytics&) = delete;
+    BookAnalytics& operator=(const BookAnalytics&) = delete;
+    
+    // Latest figures; constant time whatever the book's depth
+    LiquiditySnapshot snapshot() const;
+    
+    const AnalyticsLayout& layout() const noexcept { return layout_; }
+    
+    // Window re-anchors, and bands or sizes answered from the columns
+    uint64_t rebuilds() const noexcept { return rebuilds_.load(std::memory_order_relaxed); }
+    uint64_t fallbacks() const noexcept { return fallbacks_.load(std::memory_order_relaxed); }
+    
+    void onReset(const BookSideView& bids, const BookSideView& asks) override;
+    void onLevel(BookListener::Side side, Price price, Quantity delta) override;
+    void onCommit(const BookSideView& bids, const BookSideView& asks) override;
+    
+private:
+    // One side's trees. Side is execution::AskSide or BidSide; ticks count
+    // away from the touch, so tick 0 is the best price the window can hold.
+    template<typename Side>
+    class Ladder {
+    public:
+        explicit Ladder(size_t ticks);
+    
+        void apply(Price price, Quantity delta) noexcept;
+        // Re-anchors around the touch if it moved too far; true if rebuilt
+        bool settle(const BookSideView& view);
+        void rebuild(const BookSideView& view);
+    
+        // Size at prices no worse than `edge`
+        Quantity depthTo(Price edge, const BookSideView& view, bool& fallback) const;
+        // What walking `quantity` through the side returns
+        ExecutionResult fill(Quantity quantity, const BookSideView& view, bool& fallback) const;
+    
+    private:
+        int64_t tick(Price price) const noexcept;
+        Price priceAt(int64_t tick) const noexcept;
+        Price floor() const noexcept;  // Lowest price the window holds
+    
+        const size_t ticks_;
+        Price base_ = 0;            // Price at tick 0
+        bool stale_ = true;         // A change landed ahead of tick 0
+        Quantity window_size_ = 0;  // Everything in the window
+        Quantity beyond_ = 0;       // Everything past its far end
+        std::vector<Quantity> sizes_;   // Fenwick, 1-based
+        std::vector<int64_t> weighted_; // Fenwick of (price - floor()) * size
+    };
+    
+    void publish(const BookSideView& bids, const BookSideView& asks);
+    
+    OrderBook& book_;
+    const AnalyticsLayout layout_;
+    Ladder<execution::BidSide> bids_;
+    Ladder<execution::AskSide> asks_;
+    uint64_t sequence_ = 0;  // Written under the book's lock
+    
+    mutable std::mutex mutex_;
+    LiquiditySnapshot latest_;
+    
+    std::atomic<uint64_t> rebuilds_{0};
+    std::atomic<uint64_t> fallbacks_{0};
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "order_book.hpp"
+#include "types.hpp"
+#include <atomic>
+#include <future>
+#include <string>
+#include <vector>
+
+// One venue's slice of the aggregated book plus when it was fetched
+struct VenueBook {
+    Exchange exchange = Exchange::UNKNOWN;
+    int64_t timestamp_us = 0;
+    std::vector<PriceLevel> bids;
+    std::vector<PriceLevel> asks;
+};
+
+// Fixed-layout on-disk snapshot (host byte order), designed to be mmap'd:
+//   Header | VenueEntry[venue_count] | Level[level_count]
+// Level offsets in each VenueEntry index into the Level array. The payload
+// after the header is covered by an XXH64 checksum so torn or partial
+// files are rejected instead of served.
+namespace checkpoint_format {
+
+constexpr char kMagic[8] = {'O', 'B', 'K', 'S', 'N', 'A', 'P', '1'};
+constexpr uint32_t kVersion = 1;
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t venue_count;
+    uint64_t level_count;
+    int64_t written_us;
+    uint64_t payload_hash;
+};
+
+struct VenueEntry {
+    uint8_t exchange;
+    uint8_t reserved[7];
+    int64_t timestamp_us;
+    uint64_t bid_offset;
+    uint64_t bid_count;
+    uint64_t ask_offset;
+    uint64_t ask_count;
+};
+
+struct Level {
+    int64_t price;
+    int64_t size;
+    uint8_t exchange;
+    uint8_t reserved[7];
+};
+
+static_assert(sizeof(Header) == 40, "checkpoint header layout changed");
+static_assert(sizeof(VenueEntry) == 48, "checkpoint venue layout changed");
+static_assert(sizeof(Level) == 24, "checkpoint level layout changed");
+
+}  // namespace checkpoint_format
+
+namespace book_checkpoint {
+
+// Splits the aggregated book into per-venue books; venues without a
+// timestamp in `timestamps` are skipped
+std::vector<VenueBook> splitByVenue(
+    const OrderBook& book,
+    const std::vector<std::pair<Exchange, int64_t>>& timestamps);
+
+// Writes to `path`.tmp, fsyncs and renames, so neither readers nor a crash
+// leave a partial file under `path`
+bool save(const std::string& path, const std::vector<VenueBook>& venues, int64_t written_us);
+
+// mmaps and validates `path`; on success fills `venues` and returns true
+bool load(const std::string& path, std::vector<VenueBook>& venues, int64_t& written_us);
+
+// Runs save() on a thread of its own, so the caller's loop only pays for
+// copying the book. One save runs at a time; the destructor waits for it.
+class BackgroundWriter {
+public:
+    explicit BackgroundWriter(std::string path);
+    ~BackgroundWriter();
+    
+    BackgroundWriter(const BackgroundWriter&) = delete;
+    BackgroundWriter& operator=(const BackgroundWriter&) = delete;
+    
+    // A save is still writing; callers can skip copying the book until not
+    bool busy() const;
+    
+    // Waits for any save still running, then starts writing `venues`
+    void submit(std::vector<VenueBook> venues, int64_t written_us);
+    
+    // Waits for the save in progress, if any
+    void wait();
+    
+    uint64_t saved() const noexcept { return saved_.load(std::memory_order_relaxed); }
+    uint64_t failed() const noexcept { return failed_.load(std::memory_order_relaxed); }
+    
+private:
+    const std::string path_;
+    std::future<void> pending_;
+    std::atomic<uint64_t> saved_{0};
+    std::atomic<uint64_t> failed_{0};
+};
+
+}  // namespace book_checkpoint
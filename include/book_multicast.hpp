@@ -0,0 +1,173 @@
+#pragma once
+
+#include "order_book.hpp"
+#include "types.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+#include <netinet/in.h>
+
+// Wire format (little-endian PODs, one datagram per packet). Every packet,
+// delta or snapshot fragment, carries the next publisher sequence number so
+// receivers can detect loss, and the publisher's session id so they can
+// tell a restarted publisher (sequence back at 1) from stale duplicates.
+// Level entries are absolute: the new total size for (side, exchange,
+// price), where size 0 removes the level.
+namespace multicast_format {
+
+// PODs go on the wire as they sit in memory, with no byte swapping
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "multicast format assumes a little-endian host");
+
+constexpr uint32_t kMagic = 0x4D4B424F;  // "OBKM"
+constexpr uint16_t kVersion = 2;
+
+enum class PacketType : uint8_t {
+    DELTA = 1,
+    SNAPSHOT = 2
+};
+
+constexpr uint8_t kLastFragment = 0x01;
+constexpr uint8_t kBidSide = 0;
+constexpr uint8_t kAskSide = 1;
+
+struct PacketHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t type;
+    uint8_t flags;
+    uint64_t sequence;
+    uint64_t session;  // Random per publisher instance
+    uint32_t snapshot_id;
+    uint16_t fragment;
+    uint16_t entry_count;
+};
+
+struct WireLevel {
+    int64_t price;
+    int64_t size;
+    uint8_t side;
+    uint8_t exchange;
+    uint8_t reserved[6];
+};
+
+static_assert(sizeof(PacketHeader) == 32, "multicast header layout changed");
+static_assert(sizeof(WireLevel) == 24, "multicast level layout changed");
+
+// Keep datagrams under a 1500-byte Ethernet MTU (minus IP/UDP headers)
+constexpr size_t kMaxDatagram = 1472;
+constexpr size_t kMaxEntries = (kMaxDatagram - sizeof(PacketHeader)) / sizeof(WireLevel);
+
+}  // namespace multicast_format
+
+struct MulticastEndpoint {
+    std::string group = "239.255.42.99";
+    uint16_t port = 30001;
+    std::string interface_addr = "0.0.0.0";  // Use 127.0.0.1 for loopback-only
+    int ttl = 1;
+    
+    // "group:port", e.g. "239.255.42.99:30001"
+    static MulticastEndpoint parse(const std::string& spec);
+};
+
+// Publishes the consolidated book as sequenced deltas against what was last
+// sent, plus periodic full snapshots that receivers use to (re)synchronise.
+class BookMulticastPublisher {
+public:
+    using Sink = std::function<void(const uint8_t* data, size_t len)>;
+    
+    explicit BookMulticastPublisher(const MulticastEndpoint& endpoint);
+    explicit BookMulticastPublisher(Sink sink);  // In-process delivery (tests, replay)
+    ~BookMulticastPublisher();
+    
+    BookMulticastPublisher(const BookMulticastPublisher&) = delete;
+    BookMulticastPublisher& operator=(const BookMulticastPublisher&) = delete;
+    
+    // Returns the number of changed levels sent
+    size_t publishDelta(const OrderBook& book);
+    
+    // Returns the number of levels in the snapshot
+    size_t publishSnapshot(const OrderBook& book);
+    
+    uint64_t session() const noexcept { return session_; }
+    uint64_t packetsSent() const noexcept { return next_sequence_ - 1; }
+    uint64_t bytesSent() const noexcept { return bytes_sent_; }
+    uint64_t sendErrors() const noexcept { return send_errors_; }
+    
+private:
+    struct LevelKey {
+        uint8_t side;
+        uint8_t exchange;
+        Price price;
+        
+        bool operator<(const LevelKey& other) const noexcept {
+            if (side != other.side) return side < other.side;
+            if (exchange != other.exchange) return exchange < other.exchange;
+            return price < other.price;
+        }
+    };
+    using LevelState = std::vector<std::pair<LevelKey, Quantity>>;  // Sorted by key
+    
+    static LevelState captureState(const OrderBook& book);
+    void sendPacket(multicast_format::PacketType type, uint8_t flags, uint32_t snapshot_id,
+                    uint16_t fragment, const multicast_format::WireLevel* levels, size_t count);
+    
+    int fd_ = -1;
+    sockaddr_in destination_{};
+    Sink sink_;
+    
+    LevelState published_;
+    const uint64_t session_;
+    uint64_t next_sequence_ = 1;
+    uint32_t next_snapshot_id_ = 1;
+    uint64_t bytes_sent_ = 0;
+    uint64_t send_errors_ = 0;
+    std::vector<uint8_t> buffer_;
+};
+
+// Rebuilds an OrderBook from the publisher's stream. Deltas are applied
+// only while in sync; any sequence gap, or a new publisher session, drops
+// sync until the next complete snapshot arrives.
+class BookMulticastReceiver {
+public:
+    explicit BookMulticastReceiver(const MulticastEndpoint& endpoint);
+    BookMulticastReceiver();  // No socket; feed packets with handlePacket()
+    ~BookMulticastReceiver();
+    
+    BookMulticastReceiver(const BookMulticastReceiver&) = delete;
+    BookMulticastReceiver& operator=(const BookMulticastReceiver&) = delete;
+    
+    // Waits up to timeout_ms for the first datagram, then drains the socket.
+    // Returns the number of datagrams handled.
+    size_t poll(int timeout_ms);
+    
+    // Applies one datagram; malformed packets are counted and ignored
+    void handlePacket(const uint8_t* data, size_t len);
+    
+    const OrderBook& book() const noexcept { return book_; }
+    bool synced() const noexcept { return synced_; }
+    uint64_t gaps() const noexcept { return gaps_; }
+    uint64_t restarts() const noexcept { return restarts_; }  // Session changes seen
+    uint64_t packetsReceived() const noexcept { return packets_; }
+    uint64_t malformed() const noexcept { return malformed_; }
+    uint64_t lastSequence() const noexcept { return expected_sequence_ - 1; }
+    
+private:
+    void applyLevel(const multicast_format::WireLevel& level);
+    
+    int fd_ = -1;
+    OrderBook book_;
+    bool synced_ = false;
+    bool have_sequence_ = false;
+    uint64_t session_ = 0;
+    uint64_t expected_sequence_ = 0;
+    uint64_t gaps_ = 0;
+    uint64_t restarts_ = 0;
+    uint64_t packets_ = 0;
+    uint64_t malformed_ = 0;
+    
+    bool staging_ = false;
+    uint32_t staging_id_ = 0;
+    uint16_t next_fragment_ = 0;
+    std::vector<multicast_format::WireLevel> staged_;
+    std::vector<uint8_t> buffer_;
+};
@@ -0,0 +1,287 @@
+#pragma once
+
+#include "exchange_interface.hpp"
+#include "types.hpp"
+#include "work_stealing_pool.hpp"
+#include "json.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace book_parser {
+
+using json = nlohmann::json;
+
+namespace detail {
+
+// Largest magnitude that still fits int64 once scaled by QUANTITY_SCALE
+constexpr double kMaxNumber = 9.0e10;
+
+// Reads a numeric string field in place: no std::string copy, no exceptions.
+// Venues send plain decimals, so the leading whitespace, "nan", "inf" and
+// hex floats that strtod also takes are rejected, as is anything too large
+// to convert to Price or Quantity without undefined behaviour.
+inline bool parseNumber(const json& field, double& out) noexcept {
+    if (!field.is_string()) {
+        return false;
+    }
+    const std::string& text = field.get_ref<const std::string&>();
+    size_t first = !text.empty() && text[0] == '-' ? 1 : 0;
+    if (first == text.size() || (text[first] != '.' && (text[first] < '0' || text[first] > '9'))) {
+        return false;
+    }
+    if (text.size() > first + 1 && text[first] == '0' && (text[first + 1] == 'x' || text[first + 1] == 'X')) {
+        return false;
+    }
+    char* end = nullptr;
+    out = std::strtod(text.c_str(), &end);
+    return end == text.c_str() + text.size() && std::isfinite(out) && std::fabs(out) < kMaxNumber;
+}
+
+// Venue error pages (HTML, plain text) are rejected without running the
+// JSON parser, which builds a diagnostic message even in no-throw mode
+inline bool looksLikeObject(const std::string& body) noexcept {
+    for (char c : body) {
+        if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+            return c == '{';
+        }
+    }
+    return false;
+}
+
+struct Chunk {
+    bool is_bid;
+    size_t begin;  // Byte range of whole elements, without the outer brackets
+    size_t end;
+};
+
+// One structural pass over the body: finds the top-level "bids"/"asks"
+// arrays and cuts them into roughly chunk_bytes pieces at element commas.
+// Returns false if the body does not have the expected shape.
+bool planChunks(std::string_view body, size_t chunk_bytes,
+                std::vector<Chunk>& chunks, bool& has_bids, bool& has_asks);
+
+}  // namespace detail
+
+// Converts one JSON level into a PriceLevel, appending to `out`. Returns
+// false (without throwing) when the level has the wrong shape.
+using LevelConverter = bool (*)(const json& level, Exchange exchange,
+                                std::vector<PriceLevel>& out);
+
+// Coinbase format: ["price_string", "size_string", "num-orders"]
+inline bool arrayLevel(const json& level, Exchange exchange, std::vector<PriceLevel>& out) {
+    double price_dbl = 0;
+    double size_dbl = 0;
+    if (!level.is_array() || level.size() < 2 ||
+        !detail::parseNumber(level[0], price_dbl) || !detail::parseNumber(level[1], size_dbl)) {
+        return false;
+    }
+    
+    // FIXED: Use floor instead of round for satoshi truncation
+    // This matches how exchanges handle sub-satoshi precision
+    Price price = static_cast<Price>(price_dbl * PRICE_SCALE + 0.5);
+    Quantity size = static_cast<Quantity>(size_dbl * QUANTITY_SCALE + 0.5);
+    
+    // Validate non-zero
+    if (price > 0 && size > 0) {
+        out.emplace_back(price, size, exchange);
+    }
+    return true;
+}
+
+// Gemini format: {"price": "50000.00", "amount": "0.5"}
+inline bool objectLevel(const json& level, Exchange exchange, std::vector<PriceLevel>& out) {
+    if (!level.is_object()) {
+        return false;
+    }
+    auto price_it = level.find("price");
+    auto amount_it = level.find("amount");
+    double price_dbl = 0;
+    double amount_dbl = 0;
+    if (price_it == level.end() || amount_it == level.end() ||
+        !detail::parseNumber(*price_it, price_dbl) || !detail::parseNumber(*amount_it, amount_dbl)) {
+        return false;
+    }
+    
+    Price price = static_cast<Price>(std::round(price_dbl * PRICE_SCALE));
+    Quantity size = static_cast<Quantity>(std::round(amount_dbl * QUANTITY_SCALE));
+    
+    out.emplace_back(price, size, exchange);
+    return true;
+}
+
+// Bodies at least this large are split and parsed on the WorkStealingPool
+constexpr size_t kParallelThreshold = 256 * 1024;
+constexpr size_t kMinChunkBytes = 64 * 1024;
+
+// The parse loops are templates over the converter so a venue policy's
+// converter inlines into the per-level loop; the LevelConverter overloads
+// below instantiate them with a function pointer.
+
+// Converts the "bids" and "asks" arrays of an already parsed book object
+template<typename Convert>
+ErrorCode convertBookWith(const json& book, Exchange exchange,
+                          Convert&& convert, OrderBookSnapshot& snapshot) {
+    auto bids = book.find("bids");
+    if (bids != book.end()) {
+        snapshot.bids.reserve(bids->size());
+        for (const auto& bid : *bids) {
+            if (!convert(bid, exchange, snapshot.bids)) {
+                return ErrorCode::MALFORMED_LEVEL;
+            }
+        }
+    }
+    
+    auto asks = book.find("asks");
+    if (asks != book.end()) {
+        snapshot.asks.reserve(asks->size());
+        for (const auto& ask : *asks) {
+            if (!convert(ask, exchange, snapshot.asks)) {
+                return ErrorCode::MALFORMED_LEVEL;
+            }
+        }
+    }
+    return ErrorCode::OK;
+}
+
+// Single-threaded reference path (also used for small bodies)
+template<typename Convert>
+ErrorCode parseBookSerialWith(const std::string& body, Exchange exchange,
+                              Convert&& convert, OrderBookSnapshot& snapshot) {
+    if (!detail::looksLikeObject(body)) {
+        return ErrorCode::MALFORMED_JSON;
+    }
+    auto j = json::parse(body, nullptr, false);  // No exceptions: error bodies are routine in an outage
+    if (j.is_discarded()) {
+        return ErrorCode::MALFORMED_JSON;
+    }
+    return convertBookWith(j, exchange, convert, snapshot);
+}
+
+// For venues that wrap the book in an envelope, e.g. Kraken's
+// {"error": [], "result": {"XXBTZUSD": {"bids": ..., "asks": ...}}}.
+// `book_path` is a JSON pointer to the book object. Always serial: the chunk
+// planner only understands top-level bids/asks, and enveloped venues cap
+// their depth well below kParallelThreshold.
+template<typename Convert>
+ErrorCode parseNestedBookWith(const std::string& body, std::string_view book_path, Exchange exchange,
+                              Convert&& convert, OrderBookSnapshot& snapshot) {
+    if (!detail::looksLikeObject(body)) {
+        return ErrorCode::MALFORMED_JSON;
+    }
+    auto j = json::parse(body, nullptr, false);
+    if (j.is_discarded()) {
+        return ErrorCode::MALFORMED_JSON;
+    }
+    
+    const json* book = &j;
+    size_t pos = 0;
+    while (pos < book_path.size()) {
+        size_t next = book_path.find('/', pos + 1);
+        std::string key(book_path.substr(pos + 1, next == std::string_view::npos ? next : next - pos - 1));
+        if (!book->is_object()) {
+            return ErrorCode::MALFORMED_JSON;
+        }
+        auto it = book->find(key);
+        if (it == book->end()) {
+            return ErrorCode::MALFORMED_JSON;
+        }
+        book = &*it;
+        pos = next == std::string_view::npos ? book_path.size() : next;
+    }
+    if (!book->is_object()) {
+        return ErrorCode::MALFORMED_JSON;
+    }
+    return convertBookWith(*book, exchange, convert, snapshot);
+}
+
+// Chunked path regardless of body size
+template<typename Convert>
+ErrorCode parseBookParallelWith(const std::string& body, Exchange exchange,
+                                Convert&& convert, OrderBookSnapshot& snapshot,
+                                size_t chunk_bytes) {
+    std::vector<detail::Chunk> chunks;
+    bool has_bids = false;
+    bool has_asks = false;
+    if (!detail::planChunks(body, chunk_bytes, chunks, has_bids, has_asks)) {
+        return parseBookSerialWith(body, exchange, convert, snapshot);
+    }
+    
+    std::vector<std::vector<PriceLevel>> parsed(chunks.size());
+    std::vector<ErrorCode> errors(chunks.size(), ErrorCode::OK);
+    WorkStealingPool::instance().parallelFor(chunks.size(), [&](size_t i) {
+        const detail::Chunk& chunk = chunks[i];
+        std::string text;
+        text.reserve(chunk.end - chunk.begin + 2);
+        text.push_back('[');
+        text.append(body, chunk.begin, chunk.end - chunk.begin);
+        text.push_back(']');
+        
+        auto levels = json::parse(text, nullptr, false);
+        if (levels.is_discarded()) {
+            errors[i] = ErrorCode::MALFORMED_JSON;
+            return;
+        }
+        parsed[i].reserve(levels.size());
+        for (const auto& level : levels) {
+            if (!convert(level, exchange, parsed[i])) {
+                errors[i] = ErrorCode::MALFORMED_LEVEL;
+                return;
+            }
+        }
+    });
+    
+    for (ErrorCode error : errors) {
+        if (error != ErrorCode::OK) {
+            return error;  // First failure in document order
+        }
+    }
+    
+    // Stitch back in document order
+    size_t bid_total = 0;
+    size_t ask_total = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        (chunks[i].is_bid ? bid_total : ask_total) += parsed[i].size();
+    }
+    snapshot.bids.reserve(bid_total);
+    snapshot.asks.reserve(ask_total);
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        auto& dest = chunks[i].is_bid ? snapshot.bids : snapshot.asks;
+        dest.insert(dest.end(), parsed[i].begin(), parsed[i].end());
+    }
+    return ErrorCode::OK;
+}
+
+// Fills snapshot.bids / snapshot.asks from a {"bids": [...], "asks": [...]}
+// body. Large bodies are cut at top-level element boundaries so bids, asks
+// and chunks within each are parsed concurrently, then stitched back in
+// order. Malformed input returns MALFORMED_JSON / MALFORMED_LEVEL; nothing
+// is thrown.
+template<typename Convert>
+ErrorCode parseBookWith(const std::string& body, Exchange exchange,
+                        Convert&& convert, OrderBookSnapshot& snapshot) {
+    if (body.size() < kParallelThreshold) {
+        return parseBookSerialWith(body, exchange, convert, snapshot);
+    }
+    
+    // Aim for a few chunks per core so stealing can balance uneven levels
+    size_t workers = WorkStealingPool::instance().workerCount() + 1;
+    size_t chunk_bytes = std::max(kMinChunkBytes, body.size() / (4 * workers));
+    return parseBookParallelWith(body, exchange, convert, snapshot, chunk_bytes);
+}
+
+ErrorCode parseBook(const std::string& body, Exchange exchange,
+                    LevelConverter convert, OrderBookSnapshot& snapshot);
+
+ErrorCode parseBookSerial(const std::string& body, Exchange exchange,
+                          LevelConverter convert, OrderBookSnapshot& snapshot);
+
+// Forces the chunked path regardless of body size; exposed for benchmarks
+ErrorCode parseBookParallel(const std::string& body, Exchange exchange,
+                            LevelConverter convert, OrderBookSnapshot& snapshot,
+                            size_t chunk_bytes);
+
+}  // namespace book_parser
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "order_book.hpp"
+#include "types.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Which per-cycle aggregates are recorded. Columns are laid out as:
+//   timestamp_us,
+//   best_bid/best_ask for each venue,
+//   bid_depth/ask_depth within each bps band of the mid,
+//   buy_cost/sell_cost (cents, 0 if not fillable) for each curve size.
+struct RecorderLayout {
+    std::vector<Exchange> venues;
+    std::vector<int32_t> depth_bps{5, 10, 50};
+    std::vector<Quantity> curve_sizes{1 * QUANTITY_SCALE, 5 * QUANTITY_SCALE, 10 * QUANTITY_SCALE};
+    
+    size_t columns() const noexcept {
+        return 1 + 2 * venues.size() + 2 * depth_bps.size() + 2 * curve_sizes.size();
+    }
+    
+    std::string columnName(size_t column) const;
+    
+    // Computes one row (columns() values) from the aggregated book
+    void summarize(const OrderBook& book, int64_t timestamp_us, std::vector<int64_t>& row) const;
+};
+
+// On-disk format (host byte order):
+//   FileHeader, venue ids (uint8), bps (int32), curve sizes (int64)
+//   then blocks of: BlockHeader, uint32 column_bytes[columns], column data
+// Each column in a block is zigzag-varint delta encoded against the
+// previous row, so slowly moving prices and timestamps cost 1-2 bytes.
+namespace recorder_format {
+
+constexpr char kMagic[8] = {'O', 'B', 'K', 'R', 'E', 'C', '0', '1'};
+constexpr uint32_t kVersion = 1;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t columns;
+    uint32_t venue_count;
+    uint32_t bps_count;
+    uint32_t size_count;
+    uint32_t reserved;
+};
+
+struct BlockHeader {
+    uint32_t rows;
+    uint32_t payload_bytes;  // Column table + column data
+};
+
+}  // namespace recorder_format
+
+// Appends rows from the hot thread into an in-memory block; a background
+// thread encodes and writes full blocks so the caller never touches disk.
+class BookRecorder {
+public:
+    BookRecorder(const std::string& path, RecorderLayout layout, size_t block_rows = 4096);
+    ~BookRecorder();
+    
+    BookRecorder(const BookRecorder&) = delete;
+    BookRecorder& operator=(const BookRecorder&) = delete;
+    
+    const RecorderLayout& layout() const noexcept { return layout_; }
+    
+    // `row` must hold layout().columns() values
+    void record(const int64_t* row);
+    
+    // Summarises and records the book; call from a single producer thread
+    void recordBook(const OrderBook& book, int64_t timestamp_us);
+    
+    // Blocks until everything recorded so far is on disk
+    void flush();
+    
+    // Rows that reached the file; rows lost to a failed write are not counted
+    uint64_t rowsWritten() const;
+    
+    // A write or flush failed (ENOSPC, EIO); the recording stops short
+    bool failed() const noexcept { return failed_.load(std::memory_order_relaxed); }
+    
+private:
+    void writerLoop();
+    void writeBlock(const int64_t* rows, size_t row_count);
+    
+    RecorderLayout layout_;
+    size_t columns_;
+    size_t block_rows_;
+    std::FILE* file_;
+    
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable flushed_;
+    std::vector<int64_t> active_;      // Filled by record()
+    std::vector<int64_t> writing_;     // Owned by the writer thread
+    std::vector<int64_t> scratch_row_; // recordBook() staging
+    std::vector<uint8_t> encoded_;
+    bool flush_requested_ = false;
+    bool stop_ = false;
+    uint64_t rows_written_ = 0;
+    std::atomic<bool> failed_{false};
+    std::thread writer_;
+};
+
+// mmap-based reader; decodes a block at a time into column-major buffers.
+// Throws on open if the header does not fit the file or its layout.
+class RecordingReader {
+public:
+    explicit RecordingReader(const std::string& path);
+    ~RecordingReader();
+    
+    RecordingReader(const RecordingReader&) = delete;
+    RecordingReader& operator=(const RecordingReader&) = delete;
+    
+    const RecorderLayout& layout() const noexcept { return layout_; }
+    
+    // Decodes the next block: values[column * rows + row]. Returns false at
+    // EOF or a torn last block; throws on a block that is corrupt.
+    bool nextBlock(std::vector<int64_t>& values, size_t& rows);
+    
+    // Decodes only one column of the next block, skipping the others
+    bool nextBlockColumn(size_t column, std::vector<int64_t>& values, size_t& rows);
+    
+    void rewind() noexcept { offset_ = data_start_; }
+    
+    template<typename Func>  // Func(const int64_t* values, size_t rows, size_t row)
+    uint64_t forEachRow(Func&& func) {
+        std::vector<int64_t> values;
+        size_t rows = 0;
+        uint64_t total = 0;
+        while (nextBlock(values, rows)) {
+            for (size_t r = 0; r < rows; ++r) {
+                func(values.data(), rows, r);
+            }
+            total += rows;
+        }
+        return total;
+    }
+    
+private:
+    // Bounds-checks the block at offset_ and its column table
+    bool readBlock(recorder_format::BlockHeader& header, const uint8_t*& table) const;
+    
+    const uint8_t* base_ = nullptr;
+    size_t size_ = 0;
+    size_t data_start_ = 0;
+    size_t offset_ = 0;
+    RecorderLayout layout_;
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Failure reasons for the fetch -> parse -> quote path. Errors travel as a
+// one-byte code plus an optional integer detail (CURL code, HTTP status), and
+// messages come from a static table, so a failing venue costs no exception
+// unwinding and no string allocation.
+enum class ErrorCode : uint8_t {
+    OK = 0,
+    
+    // Transport
+    TIMEOUT,
+    DNS_FAILURE,
+    CONNECT_FAILED,
+    NETWORK_ERROR,       // Any other CURL failure; detail = CURLcode
+    RATE_LIMITED,        // HTTP 429
+    SERVER_ERROR,        // HTTP 5xx; detail = status
+    HTTP_STATUS,         // Any other non-200; detail = status
+    
+    // Parsing
+    MALFORMED_JSON,
+    MALFORMED_LEVEL,     // Level with the wrong shape or a non-numeric field
+    
+    // Quoting
+    NO_ASKS,
+    NO_BIDS,
+    INSUFFICIENT_LIQUIDITY,
+    
+    INTERNAL_ERROR,      // Unexpected exception (e.g. allocation failure)
+    COUNT
+};
+
+constexpr const char* kErrorMessages[] = {
+    "OK",
+    "Request timed out",
+    "DNS lookup failed",
+    "Connection failed",
+    "Network error",
+    "Rate limited by venue",
+    "Venue server error",
+    "Unexpected HTTP status",
+    "Malformed JSON",
+    "Malformed price level",
+    "No asks available",
+    "No bids available",
+    "Insufficient liquidity",
+    "Internal error",
+};
+
+static_assert(sizeof(kErrorMessages) / sizeof(kErrorMessages[0]) ==
+              static_cast<size_t>(ErrorCode::COUNT), "Every ErrorCode needs a message");
+
+constexpr const char* errorMessage(ErrorCode code) noexcept {
+    return static_cast<size_t>(code) < static_cast<size_t>(ErrorCode::COUNT)
+        ? kErrorMessages[static_cast<size_t>(code)]
+        : "Unknown error";
+}
+
+// Minimal expected<T, ErrorCode>: either a value or a code with detail
+template<typename T>
+class Result {
+public:
+    Result(T value) : value_(std::move(value)) {}  // NOLINT: implicit on purpose
+    
+    static Result failure(ErrorCode code, int32_t detail = 0) noexcept {
+        Result result;
+        result.code_ = code;
+        result.detail_ = detail;
+        return result;
+    }
+    
+    bool ok() const noexcept { return code_ == ErrorCode::OK; }
+    explicit operator bool() const noexcept { return ok(); }
+    
+    ErrorCode error() const noexcept { return code_; }
+    int32_t detail() const noexcept { return detail_; }
+    
+    T& value() noexcept { return value_; }
+    const T& value() const noexcept { return value_; }
+    T& operator*() noexcept { return value_; }
+    const T& operator*() const noexcept { return value_; }
+    
+private:
+    Result() = default;
+    
+    T value_{};
+    ErrorCode code_ = ErrorCode::OK;
+    int32_t detail_ = 0;
+};
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "types.hpp"
+#include "error_code.hpp"
+#include "http_client.hpp"
 #include <vector>
 #include <string>
 #include <optional>
@@ -10,10 +12,19 @@ struct OrderBookSnapshot {
     std::vector<PriceLevel> asks;
     int64_t timestamp_us;  // Microsecond precision
     bool success;
-    std::string error;
+    bool unchanged;  // Identical to this venue's previous book; bids/asks left empty
+    ErrorCode error;
+    int32_t error_detail;  // CURLcode or HTTP status, 0 if none
     
     OrderBookSnapshot() 
-        : timestamp_us(0), success(false) {}
+        : timestamp_us(0), success(false), unchanged(false),
+          error(ErrorCode::OK), error_detail(0) {}
+    
+    void fail(ErrorCode code, int32_t detail = 0) noexcept {
+        success = false;
+        error = code;
+        error_detail = detail;
+    }
 };
 
 class IExchangeClient {
@@ -22,4 +33,5 @@ public:
     virtual OrderBookSnapshot fetchOrderBook() = 0;
     virtual Exchange getExchangeId() const = 0;
     virtual std::string getName() const = 0;
+    virtual const FetchStats& fetchStats() const = 0;
 };
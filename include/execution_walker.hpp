@@ -0,0 +1,396 @@
+#pragma once
+
+#include "fixed_point.hpp"
+#include "price_calculator.hpp"
+#include "types.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace execution {
+
+// Side policies: the comparator decides which price is "better" and
+// therefore the direction the walker consumes liquidity in.
+struct AskSide {  // Buying walks asks cheapest-first
+    static constexpr ErrorCode kEmptyError = ErrorCode::NO_ASKS;
+    static constexpr int64_t kFeeSign = 1;  // Fees raise what a buyer pays
+    static constexpr bool better(Price a, Price b) noexcept { return a < b; }
+};
+
+struct BidSide {  // Selling walks bids highest-first
+    static constexpr ErrorCode kEmptyError = ErrorCode::NO_BIDS;
+    static constexpr int64_t kFeeSign = -1;  // and cut what a seller receives
+    static constexpr bool better(Price a, Price b) noexcept { return a > b; }
+};
+
+struct Crossing {
+    size_t index;              // First level where cumulative size >= target (n if none)
+    Quantity consumed_before;  // Cumulative size of levels [0, index)
+};
+
+// Sizes are read as int64 words `Stride` apart, so the same scan works over
+// a plain Quantity array (Stride 1) and over PriceLevel structs (Stride 3).
+constexpr size_t kPriceLevelStride = sizeof(PriceLevel) / sizeof(Quantity);
+static_assert(sizeof(PriceLevel) % sizeof(Quantity) == 0,
+              "PriceLevel must be a whole number of int64 words");
+
+template<size_t Stride>
+inline Crossing findCrossingScalar(const Quantity* sizes, size_t n, Quantity target,
+                                   size_t start = 0, Quantity carry = 0) noexcept {
+    for (size_t i = start; i < n; ++i) {
+        Quantity next = carry + sizes[i * Stride];
+        if (next >= target) return {i, carry};
+        carry = next;
+    }
+    return {n, carry};
+}
+
+// Vectorised prefix-sum scan: one pass, one compare-mask per vector instead
+// of a data-dependent branch per level.
+template<size_t Stride>
+inline Crossing findCrossing(const Quantity* sizes, size_t n, Quantity target) noexcept {
+    if (target <= 0) return {0, 0};
+
+    size_t i = 0;
+    Quantity carry = 0;
+
+#if defined(__AVX512F__)
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i goal = _mm512_set1_epi64(target);
+    const __m512i last = _mm512_set1_epi64(7);
+    const __m512i gather_idx = _mm512_set_epi64(
+        7 * Stride, 6 * Stride, 5 * Stride, 4 * Stride,
+        3 * Stride, 2 * Stride, 1 * Stride, 0);
+    __m512i running = zero;
+
+    for (; i + 8 <= n; i += 8) {
+        __m512i v;
+        if constexpr (Stride == 1) {
+            v = _mm512_loadu_si512(sizes + i);
+        } else {
+            v = _mm512_i64gather_epi64(gather_idx, sizes + i * Stride, 8);
+        }
+        // In-register inclusive scan: shift by 1, 2, 4 lanes and add
+        v = _mm512_add_epi64(v, _mm512_alignr_epi64(v, zero, 7));
+        v = _mm512_add_epi64(v, _mm512_alignr_epi64(v, zero, 6));
+        v = _mm512_add_epi64(v, _mm512_alignr_epi64(v, zero, 4));
+        v = _mm512_add_epi64(v, running);
+
+        __mmask8 hit = _mm512_cmpge_epi64_mask(v, goal);
+        if (hit) {
+            alignas(64) Quantity lanes[8];
+            _mm512_store_si512(lanes, v);
+            unsigned lane = static_cast<unsigned>(__builtin_ctz(hit));
+            Quantity before = lane == 0
+                ? _mm_cvtsi128_si64(_mm512_castsi512_si128(running))
+                : lanes[lane - 1];
+            return {i + lane, before};
+        }
+        running = _mm512_permutexvar_epi64(last, v);
+    }
+    carry = _mm_cvtsi128_si64(_mm512_castsi512_si128(running));
+#elif defined(__AVX2__)
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i goal = _mm256_set1_epi64x(target);
+    const __m256i gather_idx = _mm256_set_epi64x(3 * Stride, 2 * Stride, 1 * Stride, 0);
+    __m256i running = zero;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256i v;
+        if constexpr (Stride == 1) {
+            v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sizes + i));
+        } else {
+            v = _mm256_i64gather_epi64(
+                reinterpret_cast<const long long*>(sizes + i * Stride), gather_idx, 8);
+        }
+        v = _mm256_add_epi64(v, _mm256_blend_epi32(
+            _mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x03));
+        v = _mm256_add_epi64(v, _mm256_blend_epi32(
+            _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x0F));
+        v = _mm256_add_epi64(v, running);
+
+        // AVX2 only has signed greater-than: lane >= goal  <=>  !(goal > lane)
+        unsigned hit = ~static_cast<unsigned>(_mm256_movemask_pd(
+            _mm256_castsi256_pd(_mm256_cmpgt_epi64(goal, v)))) & 0xFu;
+        if (hit) {
+            alignas(32) Quantity lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+            unsigned lane = static_cast<unsigned>(__builtin_ctz(hit));
+            Quantity before = lane == 0
+                ? _mm256_extract_epi64(running, 0)
+                : lanes[lane - 1];
+            return {i + lane, before};
+        }
+        running = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    carry = _mm256_extract_epi64(running, 0);
+#endif
+
+    return findCrossingScalar<Stride>(sizes, n, target, i, carry);
+}
+
+// Side-specialised execution walker. The scan finds the crossing level in one
+// vector pass; exact fixed-point math then runs only on the fully consumed
+// levels and the final partial level. Notional is summed exactly and rounded
+// to cents once: in int64 when fitsInt64 proves the sum cannot overflow,
+// otherwise in 128 bits.
+template<typename Side>
+class ExecutionWalker {
+public:
+    // Levels must already be ordered best-first for this side
+    static ExecutionResult walkSorted(const PriceLevel* levels, size_t n,
+                                      Quantity quantity) noexcept {
+        return walkStrided<kPriceLevelStride>(&levels->price, &levels->size, n, quantity);
+    }
+
+    // Same walk over column storage (OrderBook::readAsks/readBids). The
+    // crossing scan loads sizes contiguously instead of gathering them.
+    static ExecutionResult walkColumns(const Price* prices, const Quantity* sizes, size_t n,
+                                       Quantity quantity) noexcept {
+        if (n == 0) {
+            return ExecutionResult{0, 0, false, Side::kEmptyError};
+        }
+        ExecutionResult result = walkStrided<1>(prices, sizes, n, quantity);
+        if (!result.fully_filled) {
+            result.error = ErrorCode::INSUFFICIENT_LIQUIDITY;
+        }
+        return result;
+    }
+
+    // Accepts levels in any order; only copies and sorts when they are not
+    // already ordered best-first (the aggregated book always is).
+    static ExecutionResult walk(const std::vector<PriceLevel>& levels, Quantity quantity) {
+        if (levels.empty()) {
+            ExecutionResult result{0, 0, false, Side::kEmptyError};
+            return result;
+        }
+
+        auto order = [](const PriceLevel& a, const PriceLevel& b) {
+            return Side::better(a.price, b.price);
+        };
+
+        ExecutionResult result;
+        if (std::is_sorted(levels.begin(), levels.end(), order)) {
+            result = walkSorted(levels.data(), levels.size(), quantity);
+        } else {
+            std::vector<PriceLevel> sorted = levels;
+            std::sort(sorted.begin(), sorted.end(), order);
+            result = walkSorted(sorted.data(), sorted.size(), quantity);
+        }
+
+        if (!result.fully_filled) {
+            result.error = ErrorCode::INSUFFICIENT_LIQUIDITY;
+        }
+        return result;
+    }
+
+private:
+    // Prices and sizes are read `Stride` int64 words apart: 1 for columns,
+    // kPriceLevelStride for PriceLevel arrays
+    template<size_t Stride>
+    static ExecutionResult walkStrided(const Price* prices, const Quantity* sizes, size_t n,
+                                       Quantity quantity) noexcept {
+        ExecutionResult result{0, 0, false, ErrorCode::OK};
+
+        if (quantity <= 0) {
+            result.fully_filled = (quantity == 0);
+            return result;
+        }
+
+        Crossing cross = findCrossing<Stride>(sizes, n, quantity);
+        bool crossed = cross.index < n;
+        result.fully_filled = crossed;
+        result.quantity_filled = crossed ? quantity : cross.consumed_before;
+        if (n == 0) {
+            return result;
+        }
+        Quantity partial = crossed ? quantity - cross.consumed_before : 0;
+
+        // Best-first order puts the highest price at one end of the
+        // consumed range, bounding every product by worst * filled
+        Price worst = std::max(prices[0], prices[(crossed ? cross.index : n - 1) * Stride]);
+        result.total_cost = fixed_point::fitsInt64(worst, result.quantity_filled)
+            ? sumNotional<fixed_point::NarrowNotional, Stride>(prices, sizes, cross, partial)
+            : sumNotional<fixed_point::WideNotional, Stride>(prices, sizes, cross, partial);
+
+        return result;
+    }
+
+    template<typename Notional, size_t Stride>
+    static int64_t sumNotional(const Price* prices, const Quantity* sizes, Crossing cross,
+                               Quantity partial) noexcept {
+        Notional sum;
+        for (size_t i = 0; i < cross.index; ++i) {
+            sum.add(prices[i * Stride], sizes[i * Stride]);
+        }
+        if (partial > 0) {
+            sum.add(prices[cross.index * Stride], partial);
+        }
+        return sum.cents();
+    }
+};
+
+// Splits a walk across venues as it goes. Levels are taken best-first by
+// fee-adjusted price: with equal fees that is plain book order, otherwise a
+// merge over per-venue cursors (each only moves forward, so the walk stays
+// O(n * venues) with no allocation). One walk serves any number of
+// ascending target sizes, since every smaller fill is a prefix of a larger.
+template<typename Side>
+class VenueRouter {
+public:
+    // Levels must be ordered best-first by raw price; `targets` ascending.
+    // sink(k) returns the RoutedExecution to fill for targets[k].
+    template<typename Sink>
+    static void routeSorted(const PriceLevel* levels, size_t n, const Quantity* targets, size_t count,
+                            const RoutingRules& rules, VenueMask allowed, Sink&& sink) {
+        // Levels are in raw price order whatever the fees, so the walker's
+        // int64 bound applies with the largest target
+        Price worst = n == 0 ? 0 : std::max(levels[0].price, levels[n - 1].price);
+        if (count == 0 || fixed_point::fitsInt64(worst, targets[count - 1])) {
+            routeWith<fixed_point::NarrowNotional>(levels, n, targets, count, rules, allowed, sink);
+        } else {
+            routeWith<fixed_point::WideNotional>(levels, n, targets, count, rules, allowed, sink);
+        }
+    }
+    
+    // Venues given a non-empty share below their minimum order size
+    static VenueMask undersized(const RoutedExecution& result, const RoutingRules& rules) noexcept {
+        VenueMask mask = 0;
+        for (size_t v = 0; v < kRoutedVenues; ++v) {
+            const VenueFill& fill = result.venues[v];
+            if (fill.quantity > 0 && fill.quantity < rules.venues[v].min_size) {
+                mask |= venueBit(static_cast<Exchange>(v));
+            }
+        }
+        return mask;
+    }
+    
+private:
+    static bool routable(const PriceLevel& level, VenueMask allowed) noexcept {
+        return static_cast<size_t>(level.exchange) < kRoutedVenues && (venueBit(level.exchange) & allowed);
+    }
+    
+    static int64_t adjusted(Price price, int64_t fee_ppm) noexcept {
+        return price * (FEE_SCALE + Side::kFeeSign * fee_ppm);
+    }
+    
+    // Calls visit(level) in routing order until it returns false
+    template<typename Visit>
+    static void forEachLevel(const PriceLevel* levels, size_t n, const RoutingRules& rules,
+                             VenueMask allowed, Visit&& visit) {
+        bool uniform_fees = true;
+        for (size_t v = 1; v < kRoutedVenues; ++v) {
+            uniform_fees &= rules.venues[v].taker_fee_ppm == rules.venues[0].taker_fee_ppm;
+        }
+        
+        if (uniform_fees) {
+            for (size_t i = 0; i < n; ++i) {
+                if (routable(levels[i], allowed) && !visit(levels[i])) return;
+            }
+            return;
+        }
+        
+        // Per-venue cursor at that venue's next level; n once exhausted
+        std::array<size_t, kRoutedVenues> cursor;
+        auto advance = [&](size_t v, size_t from) {
+            size_t i = from;
+            while (i < n && (static_cast<size_t>(levels[i].exchange) != v || !routable(levels[i], allowed))) ++i;
+            cursor[v] = i;
+        };
+        for (size_t v = 0; v < kRoutedVenues; ++v) advance(v, 0);
+        
+        while (true) {
+            size_t best = kRoutedVenues;
+            int64_t best_price = 0;
+            for (size_t v = 0; v < kRoutedVenues; ++v) {
+                if (cursor[v] >= n) continue;
+                int64_t price = adjusted(levels[cursor[v]].price, rules.venues[v].taker_fee_ppm);
+                if (best == kRoutedVenues || Side::better(price, best_price) ||
+                    (price == best_price && cursor[v] < cursor[best])) {
+                    best = v;
+                    best_price = price;
+                }
+            }
+            if (best == kRoutedVenues || !visit(levels[cursor[best]])) return;
+            advance(best, cursor[best] + 1);
+        }
+    }
+    
+    // Fills so far, with each venue's notional kept exact until finish()
+    template<typename Notional>
+    struct Tally {
+        std::array<VenueFill, kRoutedVenues> venues{};
+        std::array<Notional, kRoutedVenues> notional{};
+    };
+    
+    template<typename Notional, typename Sink>
+    static void routeWith(const PriceLevel* levels, size_t n, const Quantity* targets, size_t count,
+                          const RoutingRules& rules, VenueMask allowed, Sink& sink) {
+        Tally<Notional> running;
+        size_t t = 0;
+        for (; t < count && targets[t] <= 0; ++t) {
+            finish(running, sink(t), targets[t], rules, n);
+        }
+        
+        Quantity consumed = 0;
+        forEachLevel(levels, n, rules, allowed, [&](const PriceLevel& level) {
+            while (t < count && consumed + level.size >= targets[t]) {
+                Tally<Notional> crossing = running;
+                take(crossing, level, targets[t] - consumed);
+                finish(crossing, sink(t), targets[t], rules, n);
+                ++t;
+            }
+            if (t == count) {
+                return false;
+            }
+            take(running, level, level.size);
+            consumed += level.size;
+            return true;
+        });
+        
+        for (; t < count; ++t) {
+            finish(running, sink(t), targets[t], rules, n);
+        }
+    }
+    
+    template<typename Notional>
+    static void take(Tally<Notional>& tally, const PriceLevel& level, Quantity fill) noexcept {
+        size_t v = static_cast<size_t>(level.exchange);
+        VenueFill& venue = tally.venues[v];
+        venue.quantity += fill;
+        venue.worst_price = level.price;
+        ++venue.levels;
+        tally.notional[v].add(level.price, fill);
+    }
+    
+    template<typename Notional>
+    static void finish(const Tally<Notional>& tally, RoutedExecution& result, Quantity target,
+                       const RoutingRules& rules, size_t n) noexcept {
+        ExecutionResult& total = result.total;
+        total = ExecutionResult{0, 0, false, ErrorCode::OK};
+        result.total_fees = 0;
+        result.venues = tally.venues;
+        Notional exact;
+        for (size_t v = 0; v < kRoutedVenues; ++v) {
+            VenueFill& venue = result.venues[v];
+            venue.notional = tally.notional[v].cents();
+            venue.fee = (venue.notional * rules.venues[v].taker_fee_ppm + FEE_SCALE / 2) / FEE_SCALE;
+            exact.add(tally.notional[v]);
+            total.quantity_filled += venue.quantity;
+            result.total_fees += venue.fee;
+        }
+        total.total_cost = exact.cents();
+        total.fully_filled = target >= 0 && total.quantity_filled == target;
+        if (n == 0) {
+            total.error = Side::kEmptyError;
+        } else if (!total.fully_filled) {
+            total.error = ErrorCode::INSUFFICIENT_LIQUIDITY;
+        }
+    }
+};
+
+}  // namespace execution
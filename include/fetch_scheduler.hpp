@@ -0,0 +1,121 @@
+#pragma once
+
+#include "types.hpp"
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// A venue's published request budget, from its "rate_limits" block in
+// exchanges.json. The defaults match the old fixed 2000 ms limiter.
+struct VenueBudget {
+    double requests_per_second = 0.5;
+    double burst_limit = 1.0;
+    double weight_limit = 0.0;    // Request weight allowed per minute; 0 = not weight-limited
+    double request_weight = 1.0;  // Weight of one order book request
+};
+
+// Scheduler settings from the "scheduler" section, plus per-venue budgets
+struct SchedulerConfig {
+    double utilisation = 0.8;  // Fraction of each budget actually used (headroom for clock skew)
+    size_t max_in_flight = 0;  // Cap on concurrent requests across venues; 0 = one per venue
+    std::map<Exchange, VenueBudget> budgets;
+    
+    VenueBudget budgetFor(Exchange exchange) const;
+    
+    static SchedulerConfig load(const std::string& config_path);
+};
+
+// Decides when to poll each venue so the aggregated book's worst-case age
+// stays as low as the budgets allow. Each venue is polled on its own
+// cadence, the fastest its budget sustains, with at most one request in
+// flight per venue. When requests compete for max_in_flight, the venue whose
+// book will be oldest on arrival goes first. Burst tokens are spent only to
+// retry straight after a failure.
+//
+// Time is passed in explicitly so the policy can be simulated. Not
+// thread-safe: drive it from one thread.
+class FetchScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    
+    struct VenueMetrics {
+        std::string name;
+        double interval_ms = 0;     // Target spacing between requests
+        double latency_ms = 0;      // Smoothed response latency
+        double age_ms = 0;          // Current book age (-1 = no data yet)
+        double mean_age_ms = 0;     // Time-weighted mean age since first data
+        double worst_age_ms = 0;    // Oldest the book has been just before a refresh
+        uint64_t requests = 0;
+        uint64_t failures = 0;
+    };
+    
+    explicit FetchScheduler(double utilisation = 0.8, size_t max_in_flight = 0);
+    
+    // Returns the venue index used by the other calls
+    size_t addVenue(std::string name, const VenueBudget& budget, Clock::time_point now);
+    
+    // Venues to request now, most urgent first; they are marked in flight
+    std::vector<size_t> due(Clock::time_point now);
+    
+    // Earliest time due() could return a venue that is not in flight
+    Clock::time_point nextWakeup(Clock::time_point now) const;
+    
+    void onComplete(size_t venue, Clock::time_point sent, Clock::time_point received, bool success);
+    
+    size_t venues() const noexcept { return venues_.size(); }
+    uint64_t completed(size_t venue) const { return venues_[venue].completed; }
+    VenueMetrics metrics(size_t venue, Clock::time_point now) const;
+    
+    // Largest age any venue has reached so far, including its current age
+    double worstAgeMs(Clock::time_point now) const;
+    
+    void report(std::ostream& out, Clock::time_point now) const;
+    
+private:
+    struct TokenBucket {
+        double capacity = 0;  // 0 = unlimited
+        double rate = 0;      // Tokens per second
+        double tokens = 0;
+        Clock::time_point updated;
+        
+        void refill(Clock::time_point now);
+        bool has(double n) const noexcept { return capacity <= 0 || tokens >= n; }
+        void take(double n) noexcept { if (capacity > 0) tokens -= n; }
+        Clock::time_point availableAt(double n) const;
+    };
+    
+    struct Venue {
+        std::string name;
+        double weight = 1.0;
+        Clock::duration interval{};
+        TokenBucket requests;
+        TokenBucket weights;
+        
+        bool in_flight = false;
+        bool retry_now = false;
+        Clock::time_point next_due{};
+        
+        bool has_data = false;
+        Clock::time_point data_time{};  // Estimated server time of the book we hold
+        Clock::time_point last_refresh{};
+        double latency_s = 0;
+        double age_integral_s2 = 0;
+        double covered_s = 0;
+        double worst_age_s = 0;
+        
+        uint64_t sent = 0;
+        uint64_t completed = 0;
+        uint64_t failures = 0;
+        uint32_t consecutive_failures = 0;
+    };
+    
+    bool eligible(Venue& venue, Clock::time_point now);
+    double projectedAge(const Venue& venue, Clock::time_point now) const;
+    
+    double utilisation_;
+    size_t max_in_flight_;
+    size_t in_flight_ = 0;
+    std::vector<Venue> venues_;
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "types.hpp"
+#include <cstdint>
+#include <limits>
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__SIZEOF_INT128__)
+#include <intrin.h>
+#endif
+
+// Exact notional arithmetic. price * size is in cents x satoshis; one level
+// of 10,000 BTC at $100k (1e7 * 1e12) already exceeds int64, and dividing
+// each product by QUANTITY_SCALE before summing drops up to a cent per
+// level. WideNotional keeps the exact sum in 128 bits and rounds once.
+namespace fixed_point {
+
+struct U128 {
+    uint64_t hi;
+    uint64_t lo;
+};
+
+// 64 x 64 -> 128 multiply from 32-bit halves, for targets without a native
+// wide multiply (and as a cross-check for the native one in tests)
+inline U128 mulWidePortable(uint64_t a, uint64_t b) noexcept {
+    uint64_t a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_hi = a_hi * b_hi;
+
+    uint64_t middle = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+    return {hi_hi + (hi_lo >> 32) + (middle >> 32), (middle << 32) | (lo_lo & 0xFFFFFFFFu)};
+}
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 NativeU128;  // __extension__ keeps -Wpedantic quiet
+#endif
+
+inline U128 mulWide(uint64_t a, uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    NativeU128 product = static_cast<NativeU128>(a) * b;
+    return {static_cast<uint64_t>(product >> 64), static_cast<uint64_t>(product)};
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t hi;
+    uint64_t lo = _umul128(a, b, &hi);
+    return {hi, lo};
+#else
+    return mulWidePortable(a, b);
+#endif
+}
+
+// (hi:lo) / divisor for divisor < 2^32, by 32-bit long division. Only the
+// low 64 bits of the quotient are returned.
+inline uint64_t divideNarrow(U128 value, uint32_t divisor) noexcept {
+    const uint64_t limbs[4] = {value.hi >> 32, value.hi & 0xFFFFFFFFu,
+                               value.lo >> 32, value.lo & 0xFFFFFFFFu};
+    uint64_t remainder = 0;
+    uint64_t quotient = 0;
+    for (uint64_t limb : limbs) {
+        uint64_t current = (remainder << 32) | limb;
+        quotient = (quotient << 32) | (current / divisor);
+        remainder = current % divisor;
+    }
+    return quotient;
+}
+
+static_assert(QUANTITY_SCALE < (int64_t{1} << 32), "divideNarrow needs a 32-bit divisor");
+
+// Cents from a cents x satoshis product, rounded half up
+constexpr int64_t roundToCents(int64_t raw) noexcept {
+    return (raw + QUANTITY_SCALE / 2) / QUANTITY_SCALE;
+}
+
+// Proof that summing price * size in int64 cannot overflow: every product
+// is at most worst_price * size, and the sizes add up to `filled`. Leaves
+// room for the rounding half added by roundToCents.
+constexpr bool fitsInt64(Price worst_price, Quantity filled) noexcept {
+    constexpr int64_t kLimit = std::numeric_limits<int64_t>::max() - QUANTITY_SCALE / 2;
+    return worst_price <= 0 || filled <= kLimit / worst_price;
+}
+
+// Running sum of price * size (both non-negative) in cents x satoshis
+class WideNotional {
+public:
+    void add(Price price, Quantity size) noexcept {
+        addRaw(mulWide(static_cast<uint64_t>(price), static_cast<uint64_t>(size)));
+    }
+
+    void add(const WideNotional& other) noexcept { addRaw({other.hi_, other.lo_}); }
+
+    // Rounded half up to cents; the result must fit in int64 (~$92 trillion)
+    int64_t cents() const noexcept {
+        constexpr uint64_t kHalf = QUANTITY_SCALE / 2;
+        uint64_t lo = lo_ + kHalf;
+        uint64_t hi = hi_ + (lo < kHalf);
+        if (hi == 0) {
+            return static_cast<int64_t>(lo / QUANTITY_SCALE);
+        }
+        return static_cast<int64_t>(divideNarrow({hi, lo}, static_cast<uint32_t>(QUANTITY_SCALE)));
+    }
+
+    bool operator==(const WideNotional& other) const noexcept {
+        return hi_ == other.hi_ && lo_ == other.lo_;
+    }
+
+private:
+    void addRaw(U128 value) noexcept {
+        lo_ += value.lo;
+        hi_ += value.hi + (lo_ < value.lo);
+    }
+
+    uint64_t hi_ = 0;
+    uint64_t lo_ = 0;
+};
+
+// WideNotional's interface over a plain int64, for sums fitsInt64 has
+// proven cannot overflow
+class NarrowNotional {
+public:
+    void add(Price price, Quantity size) noexcept { raw_ += price * size; }
+
+    void add(const NarrowNotional& other) noexcept { raw_ += other.raw_; }
+
+    int64_t cents() const noexcept { return roundToCents(raw_); }
+
+private:
+    int64_t raw_ = 0;
+};
+
+}  // namespace fixed_point
@@ -1,11 +1,45 @@
 #pragma once
 
+#include "error_code.hpp"
 #include <string>
 #include <memory>
 #include <vector>
 #include <mutex>
+#include <atomic>
 #include <curl/curl.h>
 #include <iostream>
+
+// Validators and body fingerprint remembered per endpoint between polls
+struct ConditionalState {
+    std::string etag;           // Sent back as If-None-Match
+    std::string last_modified;  // Sent back as If-Modified-Since
+    uint64_t body_hash = 0;     // XXH64 of the last body we accepted
+    bool has_body = false;
+};
+
+enum class FetchOutcome : uint8_t {
+    CHANGED,         // New body; caller must parse it
+    NOT_MODIFIED,    // Server answered 304 to our validators
+    UNCHANGED_BODY   // 200, but byte-identical to the previous body
+};
+
+struct FetchStats {
+    std::atomic<uint64_t> changed{0};
+    std::atomic<uint64_t> not_modified{0};
+    std::atomic<uint64_t> unchanged_body{0};
+    std::atomic<uint64_t> failed{0};
+    
+    void record(FetchOutcome outcome) noexcept {
+        switch (outcome) {
+            case FetchOutcome::CHANGED: changed.fetch_add(1, std::memory_order_relaxed); break;
+            case FetchOutcome::NOT_MODIFIED: not_modified.fetch_add(1, std::memory_order_relaxed); break;
+            case FetchOutcome::UNCHANGED_BODY: unchanged_body.fetch_add(1, std::memory_order_relaxed); break;
+        }
+    }
+    
+    void recordFailure() noexcept { failed.fetch_add(1, std::memory_order_relaxed); }
+};
+
 class HTTPClient {
 public:
     HTTPClient();
@@ -14,13 +48,27 @@ public:
     HTTPClient(const HTTPClient&) = delete;
     HTTPClient& operator=(const HTTPClient&) = delete;
     
-    std::string get(const std::string& url, uint32_t timeout_ms = 5000);
+    // Failures come back as codes (never thrown): transport errors carry the
+    // CURLcode as detail, HTTP errors the status
+    Result<std::string> get(const std::string& url, uint32_t timeout_ms = 5000);
+    
+    // Conditional GET: sends the validators held in `state`, and on a 200
+    // compares the body hash against the previous poll. `body` is only
+    // filled when the outcome is CHANGED.
+    Result<FetchOutcome> getIfChanged(const std::string& url, uint32_t timeout_ms,
+                                      ConditionalState& state, std::string& body);
     
 private:
     CURL* curl_;
     std::string response_buffer_;
+    std::string etag_;
+    std::string last_modified_;
+    
+    // Returns the HTTP status of the final attempt
+    Result<long> perform(const std::string& url, uint32_t timeout_ms);
     
     static size_t writeCallback(void* contents, size_t size, size_t nmemb, void* userp);
+    static size_t headerCallback(char* buffer, size_t size, size_t nitems, void* userp);
 };
 
 class HTTPClientPool {
@@ -34,3 +82,27 @@ private:
     std::vector<std::unique_ptr<HTTPClient>> pool_;
     std::mutex mutex_;
 };
+
+// Owns the conditional-request state for one venue endpoint
+class ConditionalFetcher {
+public:
+    explicit ConditionalFetcher(std::string url) : url_(std::move(url)) {}
+    
+    Result<FetchOutcome> fetch(uint32_t timeout_ms, std::string& body);
+    
+    // Forget validators and hash so the next poll is treated as CHANGED
+    void invalidate();
+    
+    // Points the fetcher at another endpoint (config override); validators
+    // from the old one are dropped
+    void setUrl(std::string url);
+    
+    const std::string& url() const noexcept { return url_; }
+    const FetchStats& stats() const noexcept { return stats_; }
+    
+private:
+    std::string url_;
+    std::mutex mutex_;  // Serialises polls so validators stay consistent
+    ConditionalState state_;
+    FetchStats stats_;
+};
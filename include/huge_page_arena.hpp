@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+constexpr size_t kCacheLineSize = 64;
+constexpr size_t kHugePageSize = size_t{2} << 20;
+
+// Bump allocator over 2 MB-aligned chunks, so a whole book side sits behind
+// one TLB entry instead of hundreds. Each chunk is backed by explicit huge
+// pages (MAP_HUGETLB) when the kernel has some reserved, else by transparent
+// huge pages (MADV_HUGEPAGE), else by ordinary pages. Memory is only given
+// back by reset(), which keeps the largest chunk for reuse.
+class HugePageArena {
+public:
+    enum class Backing : uint8_t {
+        HUGETLB = 0,      // Reserved 2 MB pages (vm.nr_hugepages)
+        TRANSPARENT = 1,  // 2 MB-aligned mapping advised for THP
+        SMALL_PAGES = 2   // Plain 4 KB pages
+    };
+
+    // `preferred` caps how hard the arena tries: TRANSPARENT skips
+    // MAP_HUGETLB, SMALL_PAGES skips both
+    explicit HugePageArena(Backing preferred = Backing::HUGETLB) noexcept
+        : preferred_(preferred) {}
+    ~HugePageArena();
+
+    HugePageArena(const HugePageArena&) = delete;
+    HugePageArena& operator=(const HugePageArena&) = delete;
+
+    // Cache-line aligned by default; throws std::bad_alloc if no chunk
+    // can be mapped
+    void* allocate(size_t bytes, size_t align = kCacheLineSize);
+
+    template<typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T) > kCacheLineSize ? alignof(T) : kCacheLineSize));
+    }
+
+    // Invalidates everything allocated so far. The next chunk is sized for
+    // the whole previous generation, so steady state is a single mapping.
+    void reset() noexcept;
+
+    size_t reserved() const noexcept;  // Bytes currently mapped
+    Backing backing() const noexcept;  // Of the newest chunk (preferred if none yet)
+
+    static const char* backingName(Backing backing) noexcept;
+
+private:
+    struct Chunk {
+        void* base;
+        size_t size;
+        Backing backing;
+    };
+
+    Chunk map(size_t bytes) const;
+    static void unmap(const Chunk& chunk) noexcept;
+
+    Backing preferred_;
+    std::vector<Chunk> chunks_;
+    size_t offset_ = 0;     // Into chunks_.back()
+    size_t generation_ = 0; // Bytes handed out since the last reset
+    size_t high_water_ = 0; // Largest generation seen
+};
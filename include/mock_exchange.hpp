@@ -0,0 +1,91 @@
+#pragma once
+
+#include "types.hpp"
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Response delay drawn from a lognormal fitted to a median and a p99.
+// p99 <= median gives a fixed delay of `median_ms`.
+struct LatencyModel {
+    double median_ms = 0.0;
+    double p99_ms = 0.0;
+    
+    double sampleMs(std::mt19937_64& rng) const;
+};
+
+struct MockVenueConfig {
+    Exchange venue = Exchange::COINBASE;
+    size_t depth = 1000;        // Levels per side of the synthetic book
+    LatencyModel latency;
+    double error_rate = 0.0;    // Fraction of requests answered 503 with an HTML page
+    double churn = 0.0;         // Fraction of levels resized before each request
+    std::string fixture_path;   // Serve this file verbatim instead of a synthetic book
+    bool validators = true;     // false: no ETag, every poll a full 200 (as Gemini)
+};
+
+struct MockServerConfig {
+    std::string bind_addr = "127.0.0.1";
+    uint16_t port = 0;  // 0 picks a free port
+    uint64_t seed = 1;
+    std::vector<MockVenueConfig> venues;
+};
+
+// Local stand-in for the venue REST endpoints. Serves each configured venue
+// on its real path (/products/BTC-USD/book, /v1/book/BTCUSD, /api/v3/depth,
+// /0/public/Depth) in that venue's JSON format over plain HTTP/1.1 with
+// keep-alive and ETag/If-None-Match, one thread per connection.
+class MockExchangeServer {
+public:
+    // Binds and starts serving; throws std::runtime_error on socket errors
+    // or an unreadable fixture
+    explicit MockExchangeServer(MockServerConfig config);
+    ~MockExchangeServer();
+    
+    MockExchangeServer(const MockExchangeServer&) = delete;
+    MockExchangeServer& operator=(const MockExchangeServer&) = delete;
+    
+    void stop();
+    
+    uint16_t port() const noexcept { return port_; }
+    
+    // Full order-book URL for a served venue (empty if not served)
+    std::string urlFor(Exchange venue) const;
+    
+    // Writes an exchanges.json that enables exactly the served venues and
+    // points their full_url here
+    bool writeConfig(const std::string& path) const;
+    
+    static const char* pathFor(Exchange venue) noexcept;
+    
+    uint64_t requests() const noexcept { return requests_.load(std::memory_order_relaxed); }
+    uint64_t injectedErrors() const noexcept { return errors_.load(std::memory_order_relaxed); }
+    uint64_t notModified() const noexcept { return not_modified_.load(std::memory_order_relaxed); }
+    
+private:
+    struct VenueBook;
+    struct Connection;
+    
+    void acceptLoop();
+    void serve(Connection& connection);
+    std::string respond(const std::string& request);
+    
+    MockServerConfig config_;
+    std::vector<std::unique_ptr<VenueBook>> books_;
+    int listen_fd_ = -1;
+    uint16_t port_ = 0;
+    std::atomic<bool> running_{false};
+    std::thread acceptor_;
+    std::mutex connections_mutex_;
+    std::list<std::unique_ptr<Connection>> connections_;
+    
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> errors_{0};
+    std::atomic<uint64_t> not_modified_{0};
+};
@@ -1,14 +1,110 @@
 #pragma once
 
+#include "huge_page_arena.hpp"
 #include "types.hpp"
 #include <vector>
-#include <map>
+#include <functional>
 #include <shared_mutex>
 #include <memory>
+#include <atomic>
+
+// One side of the book as columns, best level first. Prices and sizes, which
+// every walk reads, are kept apart from the venue ids that only copies and
+// per-venue edits touch; each column starts on its own cache line.
+struct BookSideView {
+    const Price* prices = nullptr;
+    const Quantity* sizes = nullptr;
+    const Exchange* venues = nullptr;
+    size_t count = 0;
+};
+
+// Told about every level change as the book makes it, under the book's
+// write lock. onLevel reports net size changes per (side, price) summed
+// over venues, so a snapshot replace that only moved three levels makes
+// three calls; onCommit follows once the mutation is complete.
+class BookListener {
+public:
+    enum class Side : uint8_t { BID, ASK };
+    
+    virtual ~BookListener() = default;
+    
+    // The whole book, on attach and after clear()
+    virtual void onReset(const BookSideView& bids, const BookSideView& asks) = 0;
+    // Size at `price` on `side` moved by `delta` (negative when removed)
+    virtual void onLevel(Side side, Price price, Quantity delta) = 0;
+    virtual void onCommit(const BookSideView& bids, const BookSideView& asks) = 0;
+};
+
+// Sorted column storage for one side, ordered by Compare on price with
+// equal prices kept in insertion order. Columns are carved from one of two
+// huge-page arenas: bulk edits rebuild into the idle arena in a single
+// merge pass and then swap. Single-level edits shift in place, moving
+// whichever side of the edit is shorter into slack kept at both ends, so
+// top-of-book churn costs O(distance from the top).
+template<typename Compare>
+class BookSide {
+public:
+    explicit BookSide(HugePageArena::Backing pages);
+    
+    BookSideView view() const noexcept {
+        return {cols_.prices + head_, cols_.sizes + head_, cols_.venues + head_, count_};
+    }
+    size_t size() const noexcept { return count_; }
+    HugePageArena::Backing backing() const noexcept { return arenas_[live_].backing(); }
+    
+    void clear() noexcept { head_ = 0; count_ = 0; }
+    void insert(Price price, Quantity size, Exchange exchange);
+    void set(Price price, Quantity size, Exchange exchange);
+    
+    // Drops `exchange`'s levels (when given) and merges `levels`, in any
+    // order, after existing levels at equal prices: O(n + m log m)
+    void merge(const std::vector<PriceLevel>& levels, const Exchange* replacing = nullptr);
+    
+    void copyTo(std::vector<PriceLevel>& out) const;
+    
+    // Reports this side's level changes to `listener` (nullptr stops)
+    void listen(BookListener* listener, BookListener::Side side) noexcept {
+        listener_ = listener;
+        side_ = side;
+    }
+    
+private:
+    struct Columns {
+        Price* prices = nullptr;
+        Quantity* sizes = nullptr;
+        Exchange* venues = nullptr;
+        size_t capacity = 0;
+    };
+    
+    size_t lowerBound(Price price) const noexcept;
+    size_t upperBound(Price price) const noexcept;
+    void insertAt(size_t pos, Price price, Quantity size, Exchange exchange);
+    void eraseAt(size_t pos);
+    // Spare columns for `count` levels plus slack, and where to start them
+    Columns carveSpare(size_t count, size_t& head);
+    void swapIn(const Columns& columns, size_t head, size_t count) noexcept;
+    void notify(Price price, Quantity delta) {
+        if (listener_ && delta != 0) listener_->onLevel(side_, price, delta);
+    }
+    // Net per-price changes between a replaced venue's old and new levels
+    void notifyReplaced();
+    
+    HugePageArena arenas_[2];
+    int live_ = 0;
+    Columns cols_;
+    size_t head_ = 0;   // Index of the best level within the columns
+    size_t count_ = 0;
+    std::vector<PriceLevel> incoming_;  // Sorted copy of a merge's input
+    std::vector<PriceLevel> outgoing_;  // Levels a replace dropped, while listened to
+    BookListener* listener_ = nullptr;
+    BookListener::Side side_ = BookListener::Side::BID;
+};
 
 class OrderBook {
 public:
-    OrderBook() = default;
+    // Book storage prefers huge pages; pass a smaller backing to compare
+    explicit OrderBook(HugePageArena::Backing pages = HugePageArena::Backing::HUGETLB)
+        : bids_(pages), asks_(pages) {}
     
     void clear();
     void addBid(Price price, Quantity size, Exchange exchange);
@@ -21,13 +117,51 @@ public:
     void mergeBids(const std::vector<PriceLevel>& bids);
     void mergeAsks(const std::vector<PriceLevel>& asks);
     
+    // Set one venue's size at a price; size 0 removes the level
+    void setBidLevel(Price price, Quantity size, Exchange exchange);
+    void setAskLevel(Price price, Quantity size, Exchange exchange);
+    
+    // Swap in a venue's latest levels, leaving other venues untouched
+    void replaceExchange(Exchange exchange,
+                         const std::vector<PriceLevel>& bids,
+                         const std::vector<PriceLevel>& asks);
+    
     size_t bidDepth() const;
     size_t askDepth() const;
     
+    // Runs f(BookSideView) under the read lock, without copying levels out.
+    // The view is only valid inside f.
+    template<typename F>
+    auto readBids(F&& f) const {
+        std::shared_lock lock(mutex_);
+        return f(bids_.view());
+    }
+    
+    template<typename F>
+    auto readAsks(F&& f) const {
+        std::shared_lock lock(mutex_);
+        return f(asks_.view());
+    }
+    
+    HugePageArena::Backing backing() const;
+    
+    // Sends level changes to `listener` from now on, starting with an
+    // onReset of the current book; nullptr detaches. One listener at a time.
+    void setListener(BookListener* listener);
+    
+    // Bumped on every mutation; lets readers detect that cached results are stale
+    uint64_t version() const noexcept { return version_.load(std::memory_order_acquire); }
+    
 private:
     mutable std::shared_mutex mutex_;  // Multiple readers, single writer
+    std::atomic<uint64_t> version_{0};
+    BookListener* listener_ = nullptr;
+    
+    // Ends a mutation: hands the listener the book as it now stands
+    void commit() {
+        if (listener_) listener_->onCommit(bids_.view(), asks_.view());
+    }
     
-    // Multimap maintains sorted order: O(log n) insert
-    std::multimap<Price, PriceLevel, std::greater<Price>> bids_;  // Descending
-    std::multimap<Price, PriceLevel> asks_;  // Ascending
+    BookSide<std::greater<Price>> bids_;  // Descending
+    BookSide<std::less<Price>> asks_;     // Ascending
 };
@@ -1,14 +1,16 @@
 #pragma once
 
 #include "types.hpp"
+#include "error_code.hpp"
+#include <array>
 #include <vector>
 #include <string>
 
 struct ExecutionResult {
-    int64_t total_cost;      // In cents (fixed-point)
+    int64_t total_cost;      // In cents: exact notional, rounded half up once
     Quantity quantity_filled; // In satoshis
     bool fully_filled;
-    std::string error;
+    ErrorCode error;          // OK when fully filled; see errorMessage()
     
     [[nodiscard]] double getTotalCostUSD() const noexcept {
         return static_cast<double>(total_cost) / PRICE_SCALE;
@@ -19,6 +21,52 @@ struct ExecutionResult {
     }
 };
 
+// Venues a quote can be routed to, indexed by Exchange value
+constexpr size_t kRoutedVenues = 4;
+static_assert(static_cast<size_t>(Exchange::KRAKEN) < kRoutedVenues,
+              "every routable Exchange needs an allocation slot");
+
+constexpr int64_t FEE_SCALE = 1000000;  // Fees in parts per million (1 bp = 100)
+
+// What one venue receives of a routed order
+struct VenueFill {
+    Quantity quantity = 0;   // Satoshis
+    int64_t notional = 0;    // Cents, before fees, rounded once
+    int64_t fee = 0;         // Cents
+    Price worst_price = 0;   // Deepest level touched
+    uint32_t levels = 0;     // Levels touched, including a partial last one
+};
+
+struct VenueRule {
+    int64_t taker_fee_ppm = 0;  // Taker fee on notional
+    Quantity min_size = 0;      // Smallest order the venue accepts
+};
+
+struct RoutingRules {
+    std::array<VenueRule, kRoutedVenues> venues{};
+    VenueMask allowed = ALL_VENUES;
+    
+    VenueRule& operator[](Exchange exchange) { return venues[static_cast<size_t>(exchange)]; }
+    const VenueRule& operator[](Exchange exchange) const { return venues[static_cast<size_t>(exchange)]; }
+    
+    // Fees and minimum sizes from exchanges.json "routing" blocks; missing
+    // or invalid config means no fees and no minimums
+    static RoutingRules load(const std::string& config_path);
+};
+
+// Quote plus the per-venue split that achieves it. `total.total_cost` is
+// the whole notional rounded once (fees excluded), so it can differ from
+// the sum of the separately rounded venue notionals by a cent or two.
+// Allocation is fee-aware: with unequal fees a cheaper-all-in venue may be
+// used before a better raw price.
+struct RoutedExecution {
+    ExecutionResult total{0, 0, false, ErrorCode::OK};
+    int64_t total_fees = 0;
+    std::array<VenueFill, kRoutedVenues> venues{};
+    
+    const VenueFill& fill(Exchange exchange) const { return venues[static_cast<size_t>(exchange)]; }
+};
+
 class PriceCalculator {
 public:
     static ExecutionResult calculateBuyPrice(
@@ -28,4 +76,24 @@ public:
     static ExecutionResult calculateSellPrice(
         const std::vector<PriceLevel>& bids, 
         Quantity quantity);
+    
+    // Quote and per-venue allocation in one walk. Venues whose share would
+    // fall under their minimum size are dropped and the order re-routed
+    // without them.
+    static RoutedExecution routeBuy(const std::vector<PriceLevel>& asks, Quantity quantity,
+                                    const RoutingRules& rules = {});
+    
+    static RoutedExecution routeSell(const std::vector<PriceLevel>& bids, Quantity quantity,
+                                     const RoutingRules& rules = {});
+    
+    // Batch mode: one walk serves every size in `quantities`, writing
+    // out[i] for quantities[i]. Any order of sizes is accepted; ascending
+    // avoids the sort.
+    static void routeBuyBatch(const std::vector<PriceLevel>& asks,
+                              const std::vector<Quantity>& quantities,
+                              const RoutingRules& rules, std::vector<RoutedExecution>& out);
+    
+    static void routeSellBatch(const std::vector<PriceLevel>& bids,
+                               const std::vector<Quantity>& quantities,
+                               const RoutingRules& rules, std::vector<RoutedExecution>& out);
 };
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "order_book.hpp"
+#include "price_calculator.hpp"
+#include "types.hpp"
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+enum class QuoteSide : uint8_t {
+    BUY = 0,
+    SELL = 1
+};
+
+// Memoises ExecutionResults for one aggregated book. Entries are keyed on
+// (side, quantity, venue filter) and dropped all at once as soon as the
+// book's version moves, so repeat quotes between updates cost a hash lookup.
+class QuoteCache {
+public:
+    explicit QuoteCache(const OrderBook& book, size_t max_entries = 256)
+        : book_(book), max_entries_(max_entries) {}
+    
+    QuoteCache(const QuoteCache&) = delete;
+    QuoteCache& operator=(const QuoteCache&) = delete;
+    
+    ExecutionResult quote(QuoteSide side, Quantity quantity, VenueMask venues = ALL_VENUES);
+    
+    uint64_t hits() const noexcept { return hits_.load(std::memory_order_relaxed); }
+    uint64_t misses() const noexcept { return misses_.load(std::memory_order_relaxed); }
+    size_t size() const;
+    
+private:
+    struct Key {
+        QuoteSide side;
+        Quantity quantity;
+        VenueMask venues;
+        
+        bool operator==(const Key& other) const noexcept {
+            return side == other.side && quantity == other.quantity && venues == other.venues;
+        }
+    };
+    
+    struct KeyHash {
+        size_t operator()(const Key& k) const noexcept {
+            uint64_t h = static_cast<uint64_t>(k.quantity) * 0x9E3779B97F4A7C15ull;
+            h ^= (static_cast<uint64_t>(k.venues) << 1) | static_cast<uint64_t>(k.side);
+            return static_cast<size_t>(h ^ (h >> 29));
+        }
+    };
+    
+    static ExecutionResult compute(const OrderBook& book, QuoteSide side,
+                                   Quantity quantity, VenueMask venues);
+    
+    const OrderBook& book_;
+    const size_t max_entries_;
+    
+    mutable std::mutex mutex_;
+    uint64_t cached_version_ = 0;
+    std::unordered_map<Key, ExecutionResult, KeyHash> entries_;
+    
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+};
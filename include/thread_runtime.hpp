@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Dedicated-core runtime settings, read from the "runtime" section of
+// exchanges.json. Empty CPU lists leave that role unpinned.
+struct RuntimeConfig {
+    bool enabled = false;
+    bool busy_poll = false;  // Spin instead of sleeping on the book/query threads
+    std::vector<int> network_cpus;
+    std::vector<int> parse_cpus;
+    std::vector<int> book_cpus;
+    std::vector<int> query_cpus;
+    size_t parse_threads = 0;  // 0 = size the parse pool to the machine
+    
+    static RuntimeConfig load(const std::string& config_path);
+};
+
+namespace thread_util {
+
+// Restrict the calling thread to `cpus`; returns false if the kernel refused
+bool pinCurrentThread(const std::vector<int>& cpus);
+
+// Linux limits names to 15 characters; longer names are truncated
+void nameCurrentThread(const std::string& name);
+
+struct ContextSwitches {
+    uint64_t voluntary = 0;
+    uint64_t involuntary = 0;
+};
+
+// Registers the calling thread so ThreadRuntime::report() can find it
+void registerCurrentThread(const std::string& name);
+
+// Context switches of every registered thread, read from /proc
+std::vector<std::pair<std::string, ContextSwitches>> registeredThreadSwitches();
+
+}  // namespace thread_util
+
+// A single long-lived, named, optionally pinned thread draining a task queue
+class PinnedWorker {
+public:
+    using Task = std::function<void()>;
+    
+    PinnedWorker(std::string name, std::vector<int> cpus, bool busy_poll);
+    ~PinnedWorker();
+    
+    PinnedWorker(const PinnedWorker&) = delete;
+    PinnedWorker& operator=(const PinnedWorker&) = delete;
+    
+    template<typename Func>
+    auto submit(Func&& func) -> std::future<decltype(func())> {
+        using ReturnType = decltype(func());
+        auto task = std::make_shared<std::packaged_task<ReturnType()>>(std::forward<Func>(func));
+        auto future = task->get_future();
+        push([task]() { (*task)(); });
+        return future;
+    }
+    
+    const std::string& name() const noexcept { return name_; }
+    
+private:
+    void push(Task task);
+    void run();
+    
+    std::string name_;
+    std::vector<int> cpus_;
+    bool busy_poll_;
+    
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<Task> tasks_;
+    std::atomic<size_t> queued_{0};
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+};
+
+// The fixed thread set used when RuntimeConfig::enabled is true: one network
+// thread per venue, a pinned parse pool, one book thread and one query thread.
+class ThreadRuntime {
+public:
+    ThreadRuntime(const RuntimeConfig& config, size_t venues);
+    
+    PinnedWorker& network(size_t venue) { return *network_[venue % network_.size()]; }
+    PinnedWorker& book() { return *book_; }
+    PinnedWorker& query() { return *query_; }
+    
+    // Per-thread voluntary/involuntary context switches observed so far
+    void report(std::ostream& out) const;
+    
+private:
+    std::vector<std::unique_ptr<PinnedWorker>> network_;
+    std::unique_ptr<PinnedWorker> book_;
+    std::unique_ptr<PinnedWorker> query_;
+};
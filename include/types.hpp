@@ -1,14 +1,15 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <cstdint>
 
 // Use enum for exchange to save memory (1 byte vs 24+ bytes for std::string)
 enum class Exchange : uint8_t {
     COINBASE = 0,
     GEMINI = 1,
-    BINANCE = 2,  // Future
-    KRAKEN = 3,   // Future
+    BINANCE = 2,
+    KRAKEN = 3,
     UNKNOWN = 255
 };
 
@@ -25,7 +26,8 @@ struct PriceLevel {
     Price price;        // 8 bytes
     Quantity size;      // 8 bytes
     Exchange exchange;  // 1 byte
-    // Total: 17 bytes (vs 48+ with std::string)
+    // Total: 24 bytes with padding (vs 48+ with std::string). OrderBook
+    // stores levels as separate columns; this is the exchange format.
     
     PriceLevel(Price p, Quantity s, Exchange ex)
         : price(p), size(s), exchange(ex) {}
@@ -49,7 +51,16 @@ struct ExchangeConfig {
     uint32_t timeout_ms;
 };
 
-inline const char* exchangeName(Exchange ex) {
+// Bit set of exchanges, used to restrict a quote to a subset of venues
+using VenueMask = uint32_t;
+
+constexpr VenueMask ALL_VENUES = ~VenueMask{0};
+
+constexpr VenueMask venueBit(Exchange ex) noexcept {
+    return static_cast<uint8_t>(ex) < 32 ? VenueMask{1} << static_cast<uint8_t>(ex) : 0;
+}
+
+constexpr const char* exchangeName(Exchange ex) {
     switch(ex) {
         case Exchange::COINBASE: return "Coinbase";
         case Exchange::GEMINI: return "Gemini";
@@ -58,3 +69,13 @@ inline const char* exchangeName(Exchange ex) {
         default: return "Unknown";
     }
 }
+
+// Maps an exchanges.json id ("coinbase", ...) to its Exchange
+inline bool exchangeFromId(std::string_view id, Exchange& out) {
+    if (id == "coinbase") out = Exchange::COINBASE;
+    else if (id == "gemini") out = Exchange::GEMINI;
+    else if (id == "binance") out = Exchange::BINANCE;
+    else if (id == "kraken") out = Exchange::KRAKEN;
+    else return false;
+    return true;
+}
@@ -0,0 +1,316 @@
+#pragma once
+
+#include "book_parser.hpp"
+#include "exchange_interface.hpp"
+#include "http_client.hpp"
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace venues {
+
+using json = nlohmann::json;
+
+// Venue policies: everything that differs between venues, as compile-time
+// constants plus an inline level converter. Adding a venue means adding a
+// policy here and listing it in Registry below.
+struct Coinbase {
+    static constexpr Exchange kId = Exchange::COINBASE;
+    static constexpr const char* kName = "Coinbase";
+    static constexpr std::string_view kConfigId = "coinbase";
+    static constexpr bool kDefault = true;  // Polled when there is no usable config
+    static constexpr const char* kUrl = "https://api.exchange.coinbase.com/products/BTC-USD/book?level=2";
+    static constexpr uint32_t kTimeoutMs = 5000;
+    static constexpr std::string_view kBookPath = "";  // bids/asks at top level
+    
+    // [["price_string", "size_string", "num-orders"], ...]
+    static bool convertLevel(const json& level, Exchange exchange, std::vector<PriceLevel>& out) {
+        return book_parser::arrayLevel(level, exchange, out);
+    }
+};
+
+struct Gemini {
+    static constexpr Exchange kId = Exchange::GEMINI;
+    static constexpr const char* kName = "Gemini";
+    static constexpr std::string_view kConfigId = "gemini";
+    static constexpr bool kDefault = true;
+    static constexpr const char* kUrl = "https://api.gemini.com/v1/book/BTCUSD";
+    static constexpr uint32_t kTimeoutMs = 10000;
+    static constexpr std::string_view kBookPath = "";
+    
+    // [{"price": "50000.00", "amount": "0.5"}, ...]
+    static bool convertLevel(const json& level, Exchange exchange, std::vector<PriceLevel>& out) {
+        return book_parser::objectLevel(level, exchange, out);
+    }
+};
+
+struct Binance {
+    static constexpr Exchange kId = Exchange::BINANCE;
+    static constexpr const char* kName = "Binance";
+    static constexpr std::string_view kConfigId = "binance";
+    static constexpr bool kDefault = false;
+    static constexpr const char* kUrl = "https://api.binance.com/api/v3/depth?symbol=BTCUSDT&limit=1000";
+    static constexpr uint32_t kTimeoutMs = 4000;
+    static constexpr std::string_view kBookPath = "";
+    
+    // {"lastUpdateId": N, "bids": [["price", "qty"], ...], ...}
+    static bool convertLevel(const json& level, Exchange exchange, std::vector<PriceLevel>& out) {
+        return book_parser::arrayLevel(level, exchange, out);
+    }
+};
+
+struct Kraken {
+    static constexpr Exchange kId = Exchange::KRAKEN;
+    static constexpr const char* kName = "Kraken";
+    static constexpr std::string_view kConfigId = "kraken";
+    static constexpr bool kDefault = false;
+    static constexpr const char* kUrl = "https://api.kraken.com/0/public/Depth?pair=XXBTZUSD&count=500";
+    static constexpr uint32_t kTimeoutMs = 5000;
+    static constexpr std::string_view kBookPath = "/result/XXBTZUSD";
+    
+    // [["price", "volume", timestamp], ...] inside the result envelope
+    static bool convertLevel(const json& level, Exchange exchange, std::vector<PriceLevel>& out) {
+        return book_parser::arrayLevel(level, exchange, out);
+    }
+};
+
+// Fetch, parse and normalise for one venue, with no virtual calls; the
+// policy's converter inlines into the parser's per-level loop
+template<typename Venue>
+class VenueClient {
+public:
+    VenueClient() : fetcher_(Venue::kUrl) {}
+    
+    OrderBookSnapshot fetchOrderBook() {
+        OrderBookSnapshot snapshot;
+        snapshot.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        
+        try {
+            std::string response;
+            Result<FetchOutcome> fetched = fetcher_.fetch(Venue::kTimeoutMs, response);
+            if (!fetched) {
+                snapshot.fail(fetched.error(), fetched.detail());
+                return snapshot;
+            }
+            if (*fetched != FetchOutcome::CHANGED) {
+                // Same book as last poll: skip parse and merge entirely
+                snapshot.success = true;
+                snapshot.unchanged = true;
+                return snapshot;
+            }
+            
+            ErrorCode error = parse(response, snapshot);
+            if (error != ErrorCode::OK) {
+                snapshot.fail(error);
+                fetcher_.invalidate();  // Never short-circuit to a body we failed to parse
+                return snapshot;
+            }
+            snapshot.success = true;
+        } catch (const std::exception&) {
+            // Only allocation failures and the like get here; expected
+            // failures come back as codes
+            snapshot.fail(ErrorCode::INTERNAL_ERROR);
+        }
+        
+        return snapshot;
+    }
+    
+    // Deep books are split and parsed across cores
+    static ErrorCode parse(const std::string& body, OrderBookSnapshot& snapshot) {
+        auto convert = [](const json& level, Exchange exchange, std::vector<PriceLevel>& out) {
+            return Venue::convertLevel(level, exchange, out);
+        };
+        if constexpr (Venue::kBookPath.empty()) {
+            return book_parser::parseBookWith(body, Venue::kId, convert, snapshot);
+        } else {
+            return book_parser::parseNestedBookWith(body, Venue::kBookPath, Venue::kId, convert, snapshot);
+        }
+    }
+    
+    // Replaces the policy's URL, e.g. to point at a local mock exchange
+    void setUrl(std::string url) { fetcher_.setUrl(std::move(url)); }
+    const std::string& url() const noexcept { return fetcher_.url(); }
+    
+    const FetchStats& stats() const noexcept { return fetcher_.stats(); }
+    
+private:
+    ConditionalFetcher fetcher_;
+};
+
+// IExchangeClient adapter, for code that wants runtime polymorphism
+template<typename Venue>
+class VirtualClient : public IExchangeClient {
+public:
+    VirtualClient() = default;
+    explicit VirtualClient(std::string url) { client_.setUrl(std::move(url)); }
+    
+    OrderBookSnapshot fetchOrderBook() override { return client_.fetchOrderBook(); }
+    Exchange getExchangeId() const override { return Venue::kId; }
+    std::string getName() const override { return Venue::kName; }
+    const FetchStats& fetchStats() const override { return client_.stats(); }
+    
+private:
+    VenueClient<Venue> client_;
+};
+
+struct ConfiguredVenue {
+    std::string id;
+    std::string url;  // order_book_config.full_url; empty keeps the policy default
+};
+
+// Enabled entries of exchanges.json in file order, or nullopt when there is
+// no usable config
+std::optional<std::vector<ConfiguredVenue>> enabledVenues(const std::string& config_path);
+
+struct VenueSelection {
+    size_t slot;
+    std::string url;  // Empty: the policy's own URL
+};
+
+// Compile-time set of venues. Every venue's client lives in a tuple;
+// runtime config only decides which slots are active. Calls are routed to
+// the right client by a fold over the tuple, so there is no vtable and each
+// venue's fetch/parse path is instantiated and optimised separately.
+template<typename... Venues>
+class VenueRegistry {
+public:
+    static constexpr size_t kVenueCount = sizeof...(Venues);
+    
+    // Slot of a venue by config id; kVenueCount if the id is not registered
+    static constexpr size_t slotOf(std::string_view config_id) noexcept {
+        constexpr std::array<std::string_view, kVenueCount> ids{Venues::kConfigId...};
+        for (size_t i = 0; i < kVenueCount; ++i) {
+            if (ids[i] == config_id) return i;
+        }
+        return kVenueCount;
+    }
+    
+    static constexpr Exchange idOfSlot(size_t slot) noexcept {
+        constexpr std::array<Exchange, kVenueCount> ids{Venues::kId...};
+        return ids[slot];
+    }
+    
+    static constexpr const char* nameOfSlot(size_t slot) noexcept {
+        constexpr std::array<const char*, kVenueCount> names{Venues::kName...};
+        return names[slot];
+    }
+    
+    static constexpr bool isDefaultSlot(size_t slot) noexcept {
+        constexpr std::array<bool, kVenueCount> defaults{Venues::kDefault...};
+        return defaults[slot];
+    }
+    
+    // Enabled venues from exchanges.json, with their URL overrides.
+    // Unregistered ids are skipped; no config, or none enabled, means the
+    // default venues.
+    static std::vector<VenueSelection> selectFromConfig(const std::string& config_path) {
+        std::vector<VenueSelection> selected;
+        if (auto configured = enabledVenues(config_path)) {
+            for (const auto& venue : *configured) {
+                size_t slot = slotOf(venue.id);
+                if (slot < kVenueCount) selected.push_back({slot, venue.url});
+            }
+            if (selected.empty()) {
+                std::cerr << "Warning: No enabled exchanges found in config\n";
+            }
+        }
+        if (selected.empty()) {
+            bool first = true;
+            if (!config_path.empty()) std::cerr << "Using default exchanges (";
+            for (size_t slot = 0; slot < kVenueCount; ++slot) {
+                if (!isDefaultSlot(slot)) continue;
+                if (!config_path.empty()) std::cerr << (first ? "" : ", ") << nameOfSlot(slot);
+                selected.push_back({slot, std::string()});
+                first = false;
+            }
+            if (!config_path.empty()) std::cerr << ")\n";
+        }
+        return selected;
+    }
+    
+    void activate(const std::vector<VenueSelection>& selected) {
+        active_.clear();
+        for (const auto& venue : selected) {
+            if (venue.slot >= kVenueCount) continue;
+            if (!venue.url.empty()) {
+                visit(venue.slot, [&venue](auto& client) { client.setUrl(venue.url); });
+            }
+            active_.push_back(venue.slot);
+        }
+    }
+    
+    // Everything below is indexed by position among the active venues
+    size_t size() const noexcept { return active_.size(); }
+    Exchange id(size_t i) const noexcept { return idOfSlot(active_[i]); }
+    const char* name(size_t i) const noexcept { return nameOfSlot(active_[i]); }
+    
+    OrderBookSnapshot fetch(size_t i) {
+        return visit(active_[i], [](auto& client) { return client.fetchOrderBook(); });
+    }
+    
+    const FetchStats& stats(size_t i) {
+        const FetchStats* stats = nullptr;
+        visit(active_[i], [&stats](auto& client) { stats = &client.stats(); });
+        return *stats;
+    }
+    
+    const std::string& url(size_t i) {
+        const std::string* url = nullptr;
+        visit(active_[i], [&url](auto& client) { url = &client.url(); });
+        return *url;
+    }
+    
+    // Calls f(VenueClient<V>&) for the venue in `slot`
+    template<typename Func>
+    auto visit(size_t slot, Func&& func) {
+        return visitSlot(slot, func, std::index_sequence_for<Venues...>{});
+    }
+    
+    // Virtual client for a selected venue (used by ExchangeFactory)
+    static std::unique_ptr<IExchangeClient> makeVirtual(const VenueSelection& venue) {
+        return makeVirtualAt(venue, std::index_sequence_for<Venues...>{});
+    }
+    
+private:
+    template<size_t I>
+    using VenueAt = std::tuple_element_t<I, std::tuple<Venues...>>;
+    
+    template<size_t... I>
+    static std::unique_ptr<IExchangeClient> makeVirtualAt(const VenueSelection& venue,
+                                                          std::index_sequence<I...>) {
+        std::unique_ptr<IExchangeClient> client;
+        ((venue.slot == I ? (client = venue.url.empty()
+                                 ? std::make_unique<VirtualClient<VenueAt<I>>>()
+                                 : std::make_unique<VirtualClient<VenueAt<I>>>(venue.url), true)
+                          : false) || ...);
+        return client;
+    }
+    
+    template<typename Func, size_t... I>
+    auto visitSlot(size_t slot, Func& func, std::index_sequence<I...>) {
+        using R = decltype(func(std::get<0>(clients_)));
+        if constexpr (std::is_void_v<R>) {
+            ((slot == I ? (func(std::get<I>(clients_)), true) : false) || ...);
+        } else {
+            R result{};
+            ((slot == I ? (result = func(std::get<I>(clients_)), true) : false) || ...);
+            return result;
+        }
+    }
+    
+    std::tuple<VenueClient<Venues>...> clients_;
+    std::vector<size_t> active_;
+};
+
+using Registry = VenueRegistry<Coinbase, Gemini, Binance, Kraken>;
+
+}  // namespace venues
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of workers, each with its own deque. Owners pop from the back,
+// idle workers steal from the front of their neighbours' deques, so a few
+// slow chunks do not leave the other cores idle.
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+    using ThreadInit = std::function<void(size_t worker_index)>;
+    
+    explicit WorkStealingPool(size_t workers, ThreadInit on_start = nullptr);
+    ~WorkStealingPool();
+    
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    
+    // Shared pool sized to the machine (one core left for the caller)
+    static WorkStealingPool& instance();
+    
+    // Sets worker count (0 = machine default) and a per-thread start hook
+    // for the shared pool. Only takes effect before the first instance() call.
+    static void configure(size_t workers, ThreadInit on_start);
+    
+    size_t workerCount() const noexcept { return threads_.size(); }
+    
+    // Runs fn(0) .. fn(count - 1) across the pool and blocks until all are
+    // done. The calling thread steals work too. The first exception thrown
+    // by any task is rethrown here.
+    void parallelFor(size_t count, const std::function<void(size_t)>& fn);
+    
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+    
+    void workerLoop(size_t index, const ThreadInit& on_start);
+    bool tryRunOne(size_t home);
+    
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+    
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> pending_{0};
+    std::atomic<bool> stop_{false};
+};
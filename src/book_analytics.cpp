@@ -0,0 +1,264 @@
+#include "book_analytics.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+size_t windowTicks(size_t requested) {
+    size_t ticks = 64;
+    while (ticks < requested) ticks <<= 1;
+    return ticks;
+}
+
+template<typename Tree>
+typename Tree::value_type prefixSum(const Tree& tree, size_t count) noexcept {
+    typename Tree::value_type sum = 0;
+    for (size_t i = count; i > 0; i -= i & (~i + 1)) sum += tree[i];
+    return sum;
+}
+
+// Builds a Fenwick tree in place from per-index values at [1, n]
+template<typename Tree>
+void buildTree(Tree& tree) noexcept {
+    const size_t n = tree.size() - 1;
+    for (size_t i = 1; i <= n; ++i) {
+        size_t parent = i + (i & (~i + 1));
+        if (parent <= n) tree[parent] += tree[i];
+    }
+}
+
+}  // namespace
+
+template<typename Side>
+BookAnalytics::Ladder<Side>::Ladder(size_t ticks)
+    : ticks_(ticks), sizes_(ticks + 1, 0), weighted_(ticks + 1, 0) {}
+
+template<typename Side>
+int64_t BookAnalytics::Ladder<Side>::tick(Price price) const noexcept {
+    return Side::better(0, 1) ? price - base_ : base_ - price;
+}
+
+template<typename Side>
+Price BookAnalytics::Ladder<Side>::priceAt(int64_t tick) const noexcept {
+    return Side::better(0, 1) ? base_ + tick : base_ - tick;
+}
+
+template<typename Side>
+Price BookAnalytics::Ladder<Side>::floor() const noexcept {
+    return Side::better(0, 1) ? base_ : base_ - static_cast<Price>(ticks_ - 1);
+}
+
+template<typename Side>
+void BookAnalytics::Ladder<Side>::apply(Price price, Quantity delta) noexcept {
+    if (stale_) {
+        return;  // settle() rebuilds from the columns anyway
+    }
+    int64_t t = tick(price);
+    if (t < 0) {
+        stale_ = true;
+        return;
+    }
+    if (static_cast<size_t>(t) >= ticks_) {
+        beyond_ += delta;
+        return;
+    }
+    window_size_ += delta;
+    const int64_t weight = (priceAt(t) - floor()) * delta;
+    for (size_t i = static_cast<size_t>(t) + 1; i <= ticks_; i += i & (~i + 1)) {
+        sizes_[i] += delta;
+        weighted_[i] += weight;
+    }
+}
+
+template<typename Side>
+bool BookAnalytics::Ladder<Side>::settle(const BookSideView& view) {
+    // A quarter of the window behind the touch and three ahead; re-anchor
+    // once the touch has run half the window away from tick 0
+    int64_t t = view.count == 0 ? 0 : tick(view.prices[0]);
+    if (!stale_ && t >= 0 && static_cast<size_t>(t) <= ticks_ / 2) {
+        return false;
+    }
+    rebuild(view);
+    return true;
+}
+
+template<typename Side>
+void BookAnalytics::Ladder<Side>::rebuild(const BookSideView& view) {
+    const Price slack = static_cast<Price>(ticks_ / 4);
+    const Price touch = view.count == 0 ? 0 : view.prices[0];
+    if (Side::better(0, 1)) {
+        base_ = std::max<Price>(touch - slack, 0);
+    } else {
+        // Keeps floor() at or above zero so every notional term is non-negative
+        base_ = std::max<Price>(touch + slack, static_cast<Price>(ticks_ - 1));
+    }
+
+    std::fill(sizes_.begin(), sizes_.end(), 0);
+    std::fill(weighted_.begin(), weighted_.end(), 0);
+    window_size_ = 0;
+    beyond_ = 0;
+    for (size_t i = 0; i < view.count; ++i) {
+        int64_t t = tick(view.prices[i]);
+        if (t < 0) {
+            continue;  // Negative prices; nothing real quotes them
+        }
+        if (static_cast<size_t>(t) >= ticks_) {
+            beyond_ += view.sizes[i];
+            continue;
+        }
+        window_size_ += view.sizes[i];
+        sizes_[static_cast<size_t>(t) + 1] += view.sizes[i];
+        weighted_[static_cast<size_t>(t) + 1] += (view.prices[i] - floor()) * view.sizes[i];
+    }
+    buildTree(sizes_);
+    buildTree(weighted_);
+    stale_ = false;
+}
+
+template<typename Side>
+Quantity BookAnalytics::Ladder<Side>::depthTo(Price edge, const BookSideView& view, bool& fallback) const {
+    int64_t t = tick(edge);
+    if (t < 0) {
+        return 0;
+    }
+    if (static_cast<size_t>(t) < ticks_) {
+        return prefixSum(sizes_, static_cast<size_t>(t) + 1);
+    }
+    if (beyond_ == 0) {
+        return window_size_;
+    }
+    fallback = true;
+    const Price* end = std::upper_bound(view.prices, view.prices + view.count, edge, Side::better);
+    Quantity depth = 0;
+    for (size_t i = 0; i < static_cast<size_t>(end - view.prices); ++i) depth += view.sizes[i];
+    return depth;
+}
+
+template<typename Side>
+ExecutionResult BookAnalytics::Ladder<Side>::fill(Quantity quantity, const BookSideView& view, bool& fallback) const {
+    if (view.count == 0 || quantity <= 0 || (window_size_ < quantity && beyond_ != 0)) {
+        if (view.count != 0 && quantity > 0) fallback = true;
+        return execution::ExecutionWalker<Side>::walkColumns(view.prices, view.sizes, view.count, quantity);
+    }
+
+    // Everything the window holds, or a descent to the tick where the
+    // cumulative size reaches `quantity`
+    fixed_point::WideNotional notional;
+    if (window_size_ < quantity) {
+        notional.add(floor(), window_size_);
+        notional.add(1, prefixSum(weighted_, ticks_));
+        return ExecutionResult{notional.cents(), window_size_, false, ErrorCode::INSUFFICIENT_LIQUIDITY};
+    }
+    size_t pos = 0;
+    Quantity remaining = quantity;
+    int64_t weighted = 0;
+    for (size_t step = ticks_; step > 0; step >>= 1) {
+        if (pos + step <= ticks_ && sizes_[pos + step] < remaining) {
+            pos += step;
+            remaining -= sizes_[pos];
+            weighted += weighted_[pos];
+        }
+    }
+    notional.add(floor(), quantity - remaining);
+    notional.add(1, weighted);
+    notional.add(priceAt(static_cast<int64_t>(pos)), remaining);
+    return ExecutionResult{notional.cents(), quantity, true, ErrorCode::OK};
+}
+
+BookAnalytics::BookAnalytics(OrderBook& book, AnalyticsLayout layout, size_t window_ticks)
+    : book_(book)
+    , layout_(std::move(layout))
+    , bids_(windowTicks(window_ticks))
+    , asks_(windowTicks(window_ticks)) {
+    if (layout_.depth_bps.size() > LiquiditySnapshot::kMaxBands ||
+        layout_.vwap_sizes.size() > LiquiditySnapshot::kMaxBands) {
+        throw std::runtime_error("Too many analytics bands (max " +
+                                 std::to_string(LiquiditySnapshot::kMaxBands) + ")");
+    }
+    for (int32_t bps : layout_.depth_bps) {
+        if (bps <= 0) throw std::runtime_error("Depth bands must be positive bps");
+    }
+    for (Quantity size : layout_.vwap_sizes) {
+        if (size <= 0) throw std::runtime_error("VWAP sizes must be positive");
+    }
+    book_.setListener(this);
+}
+
+BookAnalytics::~BookAnalytics() {
+    book_.setListener(nullptr);
+}
+
+LiquiditySnapshot BookAnalytics::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return latest_;
+}
+
+void BookAnalytics::onReset(const BookSideView& bids, const BookSideView& asks) {
+    bids_.rebuild(bids);
+    asks_.rebuild(asks);
+    rebuilds_.fetch_add(2, std::memory_order_relaxed);
+    publish(bids, asks);
+}
+
+void BookAnalytics::onLevel(BookListener::Side side, Price price, Quantity delta) {
+    if (side == BookListener::Side::BID) {
+        bids_.apply(price, delta);
+    } else {
+        asks_.apply(price, delta);
+    }
+}
+
+void BookAnalytics::onCommit(const BookSideView& bids, const BookSideView& asks) {
+    uint64_t rebuilt = static_cast<uint64_t>(bids_.settle(bids)) + asks_.settle(asks);
+    if (rebuilt != 0) {
+        rebuilds_.fetch_add(rebuilt, std::memory_order_relaxed);
+    }
+    publish(bids, asks);
+}
+
+void BookAnalytics::publish(const BookSideView& bids, const BookSideView& asks) {
+    LiquiditySnapshot snap;
+    snap.sequence = ++sequence_;
+
+    // Equal prices from several venues sit next to each other at the top
+    auto touch = [](const BookSideView& view, Price& price, Quantity& size, Exchange& venue) {
+        if (view.count == 0) return;
+        price = view.prices[0];
+        venue = view.venues[0];
+        for (size_t i = 0; i < view.count && view.prices[i] == price; ++i) size += view.sizes[i];
+    };
+    touch(bids, snap.best_bid, snap.best_bid_size, snap.best_bid_venue);
+    touch(asks, snap.best_ask, snap.best_ask_size, snap.best_ask_venue);
+
+    bool fallback = false;
+    snap.two_sided = bids.count != 0 && asks.count != 0;
+    snap.band_count = layout_.depth_bps.size();
+    if (snap.two_sided) {
+        snap.mid = (snap.best_bid + snap.best_ask) / 2;
+        snap.spread = snap.best_ask - snap.best_bid;
+        snap.spread_bps = snap.mid > 0 ? static_cast<double>(snap.spread) * 10000.0 / static_cast<double>(snap.mid) : 0.0;
+    }
+    for (size_t k = 0; k < snap.band_count; ++k) {
+        auto& band = snap.bands[k];
+        band.bps = layout_.depth_bps[k];
+        if (!snap.two_sided) continue;
+        Price width = snap.mid * band.bps / 10000;
+        band.bid_depth = bids_.depthTo(snap.mid - width, bids, fallback);
+        band.ask_depth = asks_.depthTo(snap.mid + width, asks, fallback);
+    }
+
+    snap.vwap_count = layout_.vwap_sizes.size();
+    for (size_t k = 0; k < snap.vwap_count; ++k) {
+        auto& vwap = snap.vwaps[k];
+        vwap.size = layout_.vwap_sizes[k];
+        vwap.buy = asks_.fill(vwap.size, asks, fallback);
+        vwap.sell = bids_.fill(vwap.size, bids, fallback);
+    }
+    if (fallback) {
+        fallbacks_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    latest_ = snap;
+}
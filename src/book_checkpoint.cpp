@@ -0,0 +1,221 @@
+#include "book_checkpoint.hpp"
+#include "content_hash.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace book_checkpoint {
+
+using namespace checkpoint_format;
+
+namespace {
+
+// Makes a rename in the directory holding `path` durable
+void syncDirectory(const std::string& path) {
+    size_t slash = path.rfind('/');
+    std::string dir = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+}
+
+}  // namespace
+
+std::vector<VenueBook> splitByVenue(
+    const OrderBook& book,
+    const std::vector<std::pair<Exchange, int64_t>>& timestamps) {
+    
+    std::vector<VenueBook> venues;
+    for (const auto& [exchange, ts] : timestamps) {
+        VenueBook venue;
+        venue.exchange = exchange;
+        venue.timestamp_us = ts;
+        venues.push_back(std::move(venue));
+    }
+    
+    auto route = [&venues](const std::vector<PriceLevel>& levels, bool bids) {
+        for (const auto& level : levels) {
+            for (auto& venue : venues) {
+                if (venue.exchange == level.exchange) {
+                    (bids ? venue.bids : venue.asks).push_back(level);
+                    break;
+                }
+            }
+        }
+    };
+    route(book.getBids(), true);
+    route(book.getAsks(), false);
+    return venues;
+}
+
+bool save(const std::string& path, const std::vector<VenueBook>& venues, int64_t written_us) {
+    std::vector<VenueEntry> entries(venues.size());
+    std::vector<Level> levels;
+    
+    auto append = [&levels](const std::vector<PriceLevel>& src, uint64_t& offset, uint64_t& count) {
+        offset = levels.size();
+        count = src.size();
+        for (const auto& level : src) {
+            Level out{};
+            out.price = level.price;
+            out.size = level.size;
+            out.exchange = static_cast<uint8_t>(level.exchange);
+            levels.push_back(out);
+        }
+    };
+    
+    for (size_t i = 0; i < venues.size(); ++i) {
+        entries[i] = VenueEntry{};
+        entries[i].exchange = static_cast<uint8_t>(venues[i].exchange);
+        entries[i].timestamp_us = venues[i].timestamp_us;
+        append(venues[i].bids, entries[i].bid_offset, entries[i].bid_count);
+        append(venues[i].asks, entries[i].ask_offset, entries[i].ask_count);
+    }
+    
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(header.magic));
+    header.version = kVersion;
+    header.venue_count = static_cast<uint32_t>(entries.size());
+    header.level_count = levels.size();
+    header.written_us = written_us;
+    
+    uint64_t hash = content_hash::xxh64(entries.data(), entries.size() * sizeof(VenueEntry));
+    header.payload_hash = content_hash::xxh64(levels.data(), levels.size() * sizeof(Level), hash);
+    
+    const std::string tmp_path = path + ".tmp";
+    std::FILE* file = std::fopen(tmp_path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(entries.data(), sizeof(VenueEntry), entries.size(), file) == entries.size() &&
+              std::fwrite(levels.data(), sizeof(Level), levels.size(), file) == levels.size();
+    // On disk before the rename, or a crash can leave the new name on an
+    // empty file
+    ok = ok && std::fflush(file) == 0 && ::fsync(::fileno(file)) == 0;
+    ok = (std::fclose(file) == 0) && ok;
+    
+    if (!ok || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    syncDirectory(path);
+    return true;
+}
+
+bool load(const std::string& path, std::vector<VenueBook>& venues, int64_t& written_us) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        ::close(fd);
+        return false;
+    }
+    
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    
+    const auto* base = static_cast<const uint8_t*>(mapped);
+    bool ok = false;
+    
+    do {
+        Header header;
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+            break;
+        }
+        
+        // Counts come from the file: bound each against the bytes that
+        // remain before multiplying, so a crafted count cannot wrap
+        const size_t payload = size - sizeof(Header);
+        if (header.venue_count > payload / sizeof(VenueEntry)) {
+            break;
+        }
+        const size_t level_bytes = payload - header.venue_count * sizeof(VenueEntry);
+        if (header.level_count != level_bytes / sizeof(Level) || level_bytes % sizeof(Level) != 0) {
+            break;
+        }
+        
+        const auto* entries = reinterpret_cast<const VenueEntry*>(base + sizeof(Header));
+        const auto* levels = reinterpret_cast<const Level*>(entries + header.venue_count);
+        
+        uint64_t hash = content_hash::xxh64(entries, header.venue_count * sizeof(VenueEntry));
+        hash = content_hash::xxh64(levels, header.level_count * sizeof(Level), hash);
+        if (hash != header.payload_hash) {
+            break;
+        }
+        
+        auto copy = [&](uint64_t offset, uint64_t count, std::vector<PriceLevel>& out) {
+            if (offset > header.level_count || count > header.level_count - offset) {
+                return false;
+            }
+            out.reserve(count);
+            for (uint64_t i = 0; i < count; ++i) {
+                const Level& level = levels[offset + i];
+                out.emplace_back(level.price, level.size, static_cast<Exchange>(level.exchange));
+            }
+            return true;
+        };
+        
+        std::vector<VenueBook> result(header.venue_count);
+        ok = true;
+        for (uint32_t v = 0; v < header.venue_count && ok; ++v) {
+            result[v].exchange = static_cast<Exchange>(entries[v].exchange);
+            result[v].timestamp_us = entries[v].timestamp_us;
+            ok = copy(entries[v].bid_offset, entries[v].bid_count, result[v].bids) &&
+                 copy(entries[v].ask_offset, entries[v].ask_count, result[v].asks);
+        }
+        
+        if (ok) {
+            venues = std::move(result);
+            written_us = header.written_us;
+        }
+    } while (false);
+    
+    ::munmap(mapped, size);
+    return ok;
+}
+
+BackgroundWriter::BackgroundWriter(std::string path) : path_(std::move(path)) {}
+
+BackgroundWriter::~BackgroundWriter() {
+    wait();
+}
+
+bool BackgroundWriter::busy() const {
+    return pending_.valid() &&
+           pending_.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+void BackgroundWriter::submit(std::vector<VenueBook> venues, int64_t written_us) {
+    wait();
+    pending_ = std::async(std::launch::async, [this, venues = std::move(venues), written_us]() {
+        if (save(path_, venues, written_us)) {
+            saved_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            failed_.fetch_add(1, std::memory_order_relaxed);
+            std::cerr << "Warning: Could not write checkpoint " << path_ << "\n";
+        }
+    });
+}
+
+void BackgroundWriter::wait() {
+    if (pending_.valid()) {
+        pending_.get();
+    }
+}
+
+}  // namespace book_checkpoint
@@ -0,0 +1,363 @@
+#include "book_multicast.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <random>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace multicast_format;
+
+namespace {
+
+in_addr parseAddress(const std::string& addr) {
+    in_addr out{};
+    if (inet_pton(AF_INET, addr.c_str(), &out) != 1) {
+        throw std::runtime_error("Invalid IPv4 address: " + addr);
+    }
+    return out;
+}
+
+uint64_t newSession() {
+    std::random_device random;
+    return (static_cast<uint64_t>(random()) << 32) ^ random();
+}
+
+}  // namespace
+
+MulticastEndpoint MulticastEndpoint::parse(const std::string& spec) {
+    MulticastEndpoint endpoint;
+    size_t colon = spec.rfind(':');
+    if (colon == std::string::npos || colon == 0 || colon + 1 == spec.size()) {
+        throw std::runtime_error("Expected GROUP:PORT, got: " + spec);
+    }
+    endpoint.group = spec.substr(0, colon);
+    int port = std::stoi(spec.substr(colon + 1));
+    if (port <= 0 || port > 65535) {
+        throw std::runtime_error("Invalid multicast port: " + spec);
+    }
+    endpoint.port = static_cast<uint16_t>(port);
+    return endpoint;
+}
+
+// ---------------------------------------------------------------------------
+// Publisher
+// ---------------------------------------------------------------------------
+
+BookMulticastPublisher::BookMulticastPublisher(const MulticastEndpoint& endpoint)
+    : session_(newSession()), buffer_(kMaxDatagram) {
+    destination_.sin_family = AF_INET;
+    destination_.sin_port = htons(endpoint.port);
+    destination_.sin_addr = parseAddress(endpoint.group);
+    
+    fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd_ < 0) {
+        throw std::runtime_error(std::string("Failed to create multicast socket: ") + std::strerror(errno));
+    }
+    
+    unsigned char ttl = static_cast<unsigned char>(endpoint.ttl);
+    unsigned char loop = 1;  // Receivers on this host (and the tests) see our packets
+    setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+    setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+    
+    if (endpoint.interface_addr != "0.0.0.0") {
+        in_addr iface = parseAddress(endpoint.interface_addr);
+        if (setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_IF, &iface, sizeof(iface)) != 0) {
+            ::close(fd_);
+            throw std::runtime_error("Failed to select multicast interface: " + endpoint.interface_addr);
+        }
+    }
+}
+
+BookMulticastPublisher::BookMulticastPublisher(Sink sink)
+    : sink_(std::move(sink)), session_(newSession()), buffer_(kMaxDatagram) {}
+
+BookMulticastPublisher::~BookMulticastPublisher() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+BookMulticastPublisher::LevelState BookMulticastPublisher::captureState(const OrderBook& book) {
+    LevelState state;
+    auto add = [&state](const std::vector<PriceLevel>& levels, uint8_t side) {
+        for (const auto& level : levels) {
+            state.push_back({LevelKey{side, static_cast<uint8_t>(level.exchange), level.price}, level.size});
+        }
+    };
+    add(book.getBids(), kBidSide);
+    add(book.getAsks(), kAskSide);
+    
+    std::sort(state.begin(), state.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    
+    // Duplicate (side, venue, price) entries travel as one summed level
+    size_t out = 0;
+    for (size_t i = 0; i < state.size(); ++i) {
+        if (out > 0 && !(state[out - 1].first < state[i].first)) {
+            state[out - 1].second += state[i].second;
+        } else {
+            state[out++] = state[i];
+        }
+    }
+    state.resize(out);
+    return state;
+}
+
+void BookMulticastPublisher::sendPacket(PacketType type, uint8_t flags, uint32_t snapshot_id,
+                                        uint16_t fragment, const WireLevel* levels, size_t count) {
+    PacketHeader header{};
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.type = static_cast<uint8_t>(type);
+    header.flags = flags;
+    header.sequence = next_sequence_++;
+    header.session = session_;
+    header.snapshot_id = snapshot_id;
+    header.fragment = fragment;
+    header.entry_count = static_cast<uint16_t>(count);
+    
+    size_t len = sizeof(header) + count * sizeof(WireLevel);
+    std::memcpy(buffer_.data(), &header, sizeof(header));
+    std::memcpy(buffer_.data() + sizeof(header), levels, count * sizeof(WireLevel));
+    
+    if (sink_) {
+        sink_(buffer_.data(), len);
+    } else if (::sendto(fd_, buffer_.data(), len, 0,
+                        reinterpret_cast<const sockaddr*>(&destination_),
+                        sizeof(destination_)) != static_cast<ssize_t>(len)) {
+        // Best effort: receivers see the sequence gap and resync on the next snapshot
+        ++send_errors_;
+        return;
+    }
+    bytes_sent_ += len;
+}
+
+size_t BookMulticastPublisher::publishDelta(const OrderBook& book) {
+    LevelState current = captureState(book);
+    
+    std::vector<WireLevel> changes;
+    auto emit = [&changes](const LevelKey& key, Quantity size) {
+        WireLevel level{};
+        level.price = key.price;
+        level.size = size;
+        level.side = key.side;
+        level.exchange = key.exchange;
+        changes.push_back(level);
+    };
+    
+    // Both states are ordered by the same key, so one merge pass finds the diff
+    auto old_it = published_.begin();
+    auto new_it = current.begin();
+    while (old_it != published_.end() || new_it != current.end()) {
+        if (new_it == current.end() || (old_it != published_.end() && old_it->first < new_it->first)) {
+            emit(old_it->first, 0);
+            ++old_it;
+        } else if (old_it == published_.end() || new_it->first < old_it->first) {
+            emit(new_it->first, new_it->second);
+            ++new_it;
+        } else {
+            if (old_it->second != new_it->second) {
+                emit(new_it->first, new_it->second);
+            }
+            ++old_it;
+            ++new_it;
+        }
+    }
+    
+    for (size_t offset = 0; offset < changes.size(); offset += kMaxEntries) {
+        size_t count = std::min(kMaxEntries, changes.size() - offset);
+        sendPacket(PacketType::DELTA, 0, 0, 0, changes.data() + offset, count);
+    }
+    
+    published_ = std::move(current);
+    return changes.size();
+}
+
+size_t BookMulticastPublisher::publishSnapshot(const OrderBook& book) {
+    published_ = captureState(book);
+    
+    std::vector<WireLevel> levels;
+    levels.reserve(published_.size());
+    for (const auto& [key, size] : published_) {
+        WireLevel level{};
+        level.price = key.price;
+        level.size = size;
+        level.side = key.side;
+        level.exchange = key.exchange;
+        levels.push_back(level);
+    }
+    
+    uint32_t snapshot_id = next_snapshot_id_++;
+    size_t offset = 0;
+    uint16_t fragment = 0;
+    do {
+        size_t count = std::min(kMaxEntries, levels.size() - offset);
+        uint8_t flags = (offset + count == levels.size()) ? kLastFragment : 0;
+        sendPacket(PacketType::SNAPSHOT, flags, snapshot_id, fragment++, levels.data() + offset, count);
+        offset += count;
+    } while (offset < levels.size());
+    
+    return levels.size();
+}
+
+// ---------------------------------------------------------------------------
+// Receiver
+// ---------------------------------------------------------------------------
+
+BookMulticastReceiver::BookMulticastReceiver() : buffer_(kMaxDatagram) {}
+
+BookMulticastReceiver::BookMulticastReceiver(const MulticastEndpoint& endpoint)
+    : buffer_(kMaxDatagram) {
+    ip_mreq membership{};
+    membership.imr_multiaddr = parseAddress(endpoint.group);
+    membership.imr_interface = parseAddress(endpoint.interface_addr);
+    
+    fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd_ < 0) {
+        throw std::runtime_error(std::string("Failed to create multicast socket: ") + std::strerror(errno));
+    }
+    
+    // Several receivers (processes) on one host share the group port
+    int one = 1;
+    setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    setsockopt(fd_, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+    int rcvbuf = 4 << 20;  // Absorb snapshot bursts
+    setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(endpoint.port);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    
+    if (::bind(fd_, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0 ||
+        setsockopt(fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0) {
+        std::string reason = std::strerror(errno);
+        ::close(fd_);
+        throw std::runtime_error("Failed to join multicast group " + endpoint.group + ": " + reason);
+    }
+}
+
+BookMulticastReceiver::~BookMulticastReceiver() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+size_t BookMulticastReceiver::poll(int timeout_ms) {
+    if (fd_ < 0) {
+        return 0;
+    }
+    
+    pollfd pfd{fd_, POLLIN, 0};
+    if (::poll(&pfd, 1, timeout_ms) <= 0) {
+        return 0;
+    }
+    
+    size_t handled = 0;
+    while (true) {
+        ssize_t n = ::recv(fd_, buffer_.data(), buffer_.size(), MSG_DONTWAIT);
+        if (n < 0) {
+            break;
+        }
+        handlePacket(buffer_.data(), static_cast<size_t>(n));
+        ++handled;
+    }
+    return handled;
+}
+
+void BookMulticastReceiver::applyLevel(const WireLevel& level) {
+    Exchange exchange = static_cast<Exchange>(level.exchange);
+    if (level.side == kBidSide) {
+        book_.setBidLevel(level.price, level.size, exchange);
+    } else {
+        book_.setAskLevel(level.price, level.size, exchange);
+    }
+}
+
+void BookMulticastReceiver::handlePacket(const uint8_t* data, size_t len) {
+    PacketHeader header;
+    if (len < sizeof(header)) {
+        ++malformed_;
+        return;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != kMagic || header.version != kVersion ||
+        len != sizeof(header) + header.entry_count * sizeof(WireLevel)) {
+        ++malformed_;
+        return;
+    }
+    ++packets_;
+    
+    // A restarted publisher counts from 1 again; its packets are not
+    // duplicates, and the book it describes starts from its first snapshot
+    if (have_sequence_ && header.session != session_) {
+        ++restarts_;
+        have_sequence_ = false;
+        synced_ = false;
+        staging_ = false;
+    }
+    session_ = header.session;
+    
+    if (have_sequence_ && header.sequence != expected_sequence_) {
+        if (header.sequence < expected_sequence_) {
+            return;  // Duplicate or reordered; already superseded
+        }
+        ++gaps_;
+        synced_ = false;
+        staging_ = false;
+    }
+    have_sequence_ = true;
+    expected_sequence_ = header.sequence + 1;
+    
+    const uint8_t* payload = data + sizeof(header);
+    auto levelAt = [payload](size_t i) {
+        WireLevel level;
+        std::memcpy(&level, payload + i * sizeof(WireLevel), sizeof(level));
+        return level;
+    };
+    
+    if (header.type == static_cast<uint8_t>(PacketType::DELTA)) {
+        if (!synced_) {
+            return;  // Deltas are meaningless until a snapshot establishes the base
+        }
+        for (size_t i = 0; i < header.entry_count; ++i) {
+            applyLevel(levelAt(i));
+        }
+        return;
+    }
+    
+    if (header.type != static_cast<uint8_t>(PacketType::SNAPSHOT)) {
+        ++malformed_;
+        return;
+    }
+    
+    if (header.fragment == 0) {
+        staging_ = true;
+        staging_id_ = header.snapshot_id;
+        next_fragment_ = 0;
+        staged_.clear();
+    }
+    if (!staging_ || header.snapshot_id != staging_id_ || header.fragment != next_fragment_) {
+        staging_ = false;
+        return;
+    }
+    
+    for (size_t i = 0; i < header.entry_count; ++i) {
+        staged_.push_back(levelAt(i));
+    }
+    ++next_fragment_;
+    
+    if (header.flags & kLastFragment) {
+        book_.clear();
+        for (const auto& level : staged_) {
+            applyLevel(level);
+        }
+        staged_.clear();
+        staging_ = false;
+        synced_ = true;
+    }
+}
@@ -0,0 +1,89 @@
+#include "book_parser.hpp"
+
+namespace book_parser {
+
+namespace detail {
+
+bool planChunks(std::string_view body, size_t chunk_bytes,
+                std::vector<Chunk>& chunks, bool& has_bids, bool& has_asks) {
+    int depth = 0;
+    bool in_string = false;
+    size_t key_begin = 0;
+    std::string_view last_key;
+    int array_side = -1;  // -1 none, 1 bids, 0 asks
+    size_t chunk_begin = 0;
+    
+    for (size_t i = 0; i < body.size(); ++i) {
+        char c = body[i];
+        
+        if (in_string) {
+            if (c == '\\') {
+                ++i;
+            } else if (c == '"') {
+                in_string = false;
+                if (depth == 1) {
+                    last_key = body.substr(key_begin, i - key_begin);
+                }
+            }
+            continue;
+        }
+        
+        switch (c) {
+            case '"':
+                in_string = true;
+                key_begin = i + 1;
+                break;
+            case '{':
+            case '[':
+                ++depth;
+                if (c == '[' && depth == 2 && (last_key == "bids" || last_key == "asks")) {
+                    array_side = last_key == "bids" ? 1 : 0;
+                    (array_side ? has_bids : has_asks) = true;
+                    chunk_begin = i + 1;
+                }
+                break;
+            case '}':
+            case ']':
+                if (depth == 2 && array_side >= 0) {
+                    if (i > chunk_begin) {
+                        chunks.push_back({array_side == 1, chunk_begin, i});
+                    }
+                    array_side = -1;
+                }
+                if (--depth < 0) return false;
+                break;
+            case ',':
+                if (depth == 1) {
+                    last_key = {};
+                } else if (depth == 2 && array_side >= 0 && i - chunk_begin >= chunk_bytes) {
+                    chunks.push_back({array_side == 1, chunk_begin, i});
+                    chunk_begin = i + 1;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    
+    return depth == 0 && !in_string && (has_bids || has_asks);
+}
+
+}  // namespace detail
+
+ErrorCode parseBook(const std::string& body, Exchange exchange,
+                    LevelConverter convert, OrderBookSnapshot& snapshot) {
+    return parseBookWith(body, exchange, convert, snapshot);
+}
+
+ErrorCode parseBookSerial(const std::string& body, Exchange exchange,
+                          LevelConverter convert, OrderBookSnapshot& snapshot) {
+    return parseBookSerialWith(body, exchange, convert, snapshot);
+}
+
+ErrorCode parseBookParallel(const std::string& body, Exchange exchange,
+                            LevelConverter convert, OrderBookSnapshot& snapshot,
+                            size_t chunk_bytes) {
+    return parseBookParallelWith(body, exchange, convert, snapshot, chunk_bytes);
+}
+
+}  // namespace book_parser
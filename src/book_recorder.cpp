@@ -0,0 +1,407 @@
+#include "book_recorder.hpp"
+#include "execution_walker.hpp"
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+inline uint64_t zigzag(int64_t v) noexcept {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline int64_t unzigzag(uint64_t v) noexcept {
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+inline void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+// False if the varint runs past `end` or past 64 bits
+inline bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& v) noexcept {
+    v = 0;
+    for (int shift = 0; shift <= 63 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Decodes `rows` delta-encoded values from [p, end) into out[0..rows)
+inline bool decodeColumn(const uint8_t* p, const uint8_t* end, size_t rows, int64_t* out) noexcept {
+    uint64_t prev = 0;
+    for (size_t r = 0; r < rows; ++r) {
+        uint64_t v;
+        if (!getVarint(p, end, v)) {
+            return false;
+        }
+        prev += static_cast<uint64_t>(unzigzag(v));  // Wraps like the encoder's subtraction
+        out[r] = static_cast<int64_t>(prev);
+    }
+    return true;
+}
+
+}  // namespace
+
+std::string RecorderLayout::columnName(size_t column) const {
+    if (column == 0) return "timestamp_us";
+    --column;
+    if (column < 2 * venues.size()) {
+        return std::string(exchangeName(venues[column / 2])) + (column % 2 ? ".best_ask" : ".best_bid");
+    }
+    column -= 2 * venues.size();
+    if (column < 2 * depth_bps.size()) {
+        return (column % 2 ? "ask_depth_" : "bid_depth_") + std::to_string(depth_bps[column / 2]) + "bps";
+    }
+    column -= 2 * depth_bps.size();
+    return (column % 2 ? "sell_cost_" : "buy_cost_") + std::to_string(curve_sizes[column / 2]) + "sat";
+}
+
+void RecorderLayout::summarize(const OrderBook& book, int64_t timestamp_us,
+                               std::vector<int64_t>& row) const {
+    row.assign(columns(), 0);
+    auto bids = book.getBids();  // Best-first
+    auto asks = book.getAsks();
+    
+    size_t col = 0;
+    row[col++] = timestamp_us;
+    
+    for (Exchange venue : venues) {
+        for (const auto& bid : bids) {
+            if (bid.exchange == venue) { row[col] = bid.price; break; }
+        }
+        for (const auto& ask : asks) {
+            if (ask.exchange == venue) { row[col + 1] = ask.price; break; }
+        }
+        col += 2;
+    }
+    
+    if (!bids.empty() && !asks.empty()) {
+        Price mid = (bids.front().price + asks.front().price) / 2;
+        for (int32_t bps : depth_bps) {
+            Price band = mid * bps / 10000;
+            Quantity bid_depth = 0;
+            Quantity ask_depth = 0;
+            for (const auto& bid : bids) {
+                if (bid.price < mid - band) break;
+                bid_depth += bid.size;
+            }
+            for (const auto& ask : asks) {
+                if (ask.price > mid + band) break;
+                ask_depth += ask.size;
+            }
+            row[col++] = bid_depth;
+            row[col++] = ask_depth;
+        }
+    } else {
+        col += 2 * depth_bps.size();
+    }
+    
+    for (Quantity size : curve_sizes) {
+        auto buy = execution::ExecutionWalker<execution::AskSide>::walkSorted(
+            asks.data(), asks.size(), size);
+        auto sell = execution::ExecutionWalker<execution::BidSide>::walkSorted(
+            bids.data(), bids.size(), size);
+        row[col++] = buy.fully_filled ? buy.total_cost : 0;
+        row[col++] = sell.fully_filled ? sell.total_cost : 0;
+    }
+}
+
+BookRecorder::BookRecorder(const std::string& path, RecorderLayout layout, size_t block_rows)
+    : layout_(std::move(layout))
+    , columns_(layout_.columns())
+    , block_rows_(std::max<size_t>(block_rows, 1))
+    , file_(std::fopen(path.c_str(), "wb")) {
+    if (!file_) {
+        throw std::runtime_error("Failed to open recording file: " + path);
+    }
+    
+    recorder_format::FileHeader header{};
+    std::memcpy(header.magic, recorder_format::kMagic, sizeof(header.magic));
+    header.version = recorder_format::kVersion;
+    header.columns = static_cast<uint32_t>(columns_);
+    header.venue_count = static_cast<uint32_t>(layout_.venues.size());
+    header.bps_count = static_cast<uint32_t>(layout_.depth_bps.size());
+    header.size_count = static_cast<uint32_t>(layout_.curve_sizes.size());
+    std::fwrite(&header, sizeof(header), 1, file_);
+    for (Exchange venue : layout_.venues) {
+        uint8_t id = static_cast<uint8_t>(venue);
+        std::fwrite(&id, 1, 1, file_);
+    }
+    std::fwrite(layout_.depth_bps.data(), sizeof(int32_t), layout_.depth_bps.size(), file_);
+    std::fwrite(layout_.curve_sizes.data(), sizeof(Quantity), layout_.curve_sizes.size(), file_);
+    if (std::fflush(file_) != 0 || std::ferror(file_)) {
+        std::fclose(file_);
+        throw std::runtime_error("Failed to write recording header: " + path);
+    }
+    
+    active_.reserve(block_rows_ * columns_);
+    writing_.reserve(block_rows_ * columns_);
+    writer_ = std::thread([this]() { writerLoop(); });
+}
+
+BookRecorder::~BookRecorder() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    writer_.join();
+    if (std::fclose(file_) != 0 && !failed_.exchange(true)) {
+        std::cerr << "Warning: Recording incomplete, close failed\n";
+    }
+}
+
+void BookRecorder::record(const int64_t* row) {
+    bool full;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        active_.insert(active_.end(), row, row + columns_);
+        full = active_.size() >= block_rows_ * columns_;
+    }
+    if (full) {
+        wake_.notify_one();
+    }
+}
+
+void BookRecorder::recordBook(const OrderBook& book, int64_t timestamp_us) {
+    layout_.summarize(book, timestamp_us, scratch_row_);
+    record(scratch_row_.data());
+}
+
+void BookRecorder::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    flush_requested_ = true;
+    wake_.notify_one();
+    flushed_.wait(lock, [this]() { return !flush_requested_; });
+}
+
+uint64_t BookRecorder::rowsWritten() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rows_written_;
+}
+
+void BookRecorder::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this]() {
+            return stop_ || flush_requested_ || active_.size() >= block_rows_ * columns_;
+        });
+        
+        bool finishing = stop_;
+        bool flushing = flush_requested_;
+        writing_.clear();
+        writing_.swap(active_);
+        
+        // Encode and write without holding the lock
+        lock.unlock();
+        const size_t total_rows = writing_.size() / columns_;
+        for (size_t first = 0; first < total_rows; first += block_rows_) {
+            writeBlock(writing_.data() + first * columns_,
+                       std::min(block_rows_, total_rows - first));
+        }
+        if (flushing || finishing) {
+            std::fflush(file_);
+        }
+        // ENOSPC and EIO stick on the stream; rows after that are lost
+        bool ok = !std::ferror(file_);
+        if (!ok) {
+            failed_.store(true, std::memory_order_relaxed);
+        }
+        lock.lock();
+        
+        if (ok) {
+            rows_written_ += writing_.size() / columns_;
+        }
+        if (flushing) {
+            flush_requested_ = false;
+            flushed_.notify_all();
+        }
+        if (finishing && active_.empty()) {
+            return;
+        }
+    }
+}
+
+void BookRecorder::writeBlock(const int64_t* rows, size_t row_count) {
+    if (row_count == 0) return;
+    
+    std::vector<uint32_t> column_bytes(columns_);
+    encoded_.clear();
+    for (size_t c = 0; c < columns_; ++c) {
+        size_t before = encoded_.size();
+        int64_t prev = 0;
+        for (size_t r = 0; r < row_count; ++r) {
+            int64_t value = rows[r * columns_ + c];
+            putVarint(encoded_, zigzag(value - prev));
+            prev = value;
+        }
+        column_bytes[c] = static_cast<uint32_t>(encoded_.size() - before);
+    }
+    
+    recorder_format::BlockHeader header{};
+    header.rows = static_cast<uint32_t>(row_count);
+    header.payload_bytes = static_cast<uint32_t>(columns_ * sizeof(uint32_t) + encoded_.size());
+    std::fwrite(&header, sizeof(header), 1, file_);
+    std::fwrite(column_bytes.data(), sizeof(uint32_t), columns_, file_);
+    std::fwrite(encoded_.data(), 1, encoded_.size(), file_);
+}
+
+RecordingReader::RecordingReader(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open recording: " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(recorder_format::FileHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Recording too small: " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Failed to mmap recording: " + path);
+    }
+    base_ = static_cast<const uint8_t*>(mapped);
+    ::madvise(mapped, size_, MADV_SEQUENTIAL);
+    
+    auto reject = [&](const char* reason) {
+        ::munmap(mapped, size_);
+        base_ = nullptr;
+        throw std::runtime_error(reason + path);
+    };
+    
+    recorder_format::FileHeader header;
+    std::memcpy(&header, base_, sizeof(header));
+    if (std::memcmp(header.magic, recorder_format::kMagic, sizeof(header.magic)) != 0 ||
+        header.version != recorder_format::kVersion) {
+        reject("Not a book recording: ");
+    }
+    
+    // Counts come from the file: bound each table by the bytes left before
+    // reading it, so a recorder killed mid-header cannot fault the reader
+    size_t remaining = size_ - sizeof(header);
+    if (header.venue_count > remaining) {
+        reject("Truncated recording header: ");
+    }
+    remaining -= header.venue_count;
+    if (header.bps_count > remaining / sizeof(int32_t)) {
+        reject("Truncated recording header: ");
+    }
+    remaining -= header.bps_count * sizeof(int32_t);
+    if (header.size_count > remaining / sizeof(Quantity)) {
+        reject("Truncated recording header: ");
+    }
+    
+    size_t offset = sizeof(header);
+    for (uint32_t i = 0; i < header.venue_count; ++i) {
+        layout_.venues.push_back(static_cast<Exchange>(base_[offset++]));
+    }
+    layout_.depth_bps.resize(header.bps_count);
+    std::memcpy(layout_.depth_bps.data(), base_ + offset, header.bps_count * sizeof(int32_t));
+    offset += header.bps_count * sizeof(int32_t);
+    layout_.curve_sizes.resize(header.size_count);
+    std::memcpy(layout_.curve_sizes.data(), base_ + offset, header.size_count * sizeof(Quantity));
+    offset += header.size_count * sizeof(Quantity);
+    if (header.columns != layout_.columns()) {
+        reject("Recording column count does not match its layout: ");
+    }
+    
+    data_start_ = offset_ = offset;
+}
+
+RecordingReader::~RecordingReader() {
+    if (base_) {
+        ::munmap(const_cast<uint8_t*>(base_), size_);
+    }
+}
+
+bool RecordingReader::readBlock(recorder_format::BlockHeader& header, const uint8_t*& table) const {
+    const size_t columns = layout_.columns();
+    if (size_ - offset_ < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, base_ + offset_, sizeof(header));
+    if (header.payload_bytes > size_ - offset_ - sizeof(header)) {
+        return false;  // Torn tail
+    }
+    
+    // Every column must lie inside the payload, and every row costs at
+    // least one byte in each column
+    if (header.payload_bytes / sizeof(uint32_t) < columns) {
+        throw std::runtime_error("Corrupt recording block: column table exceeds payload");
+    }
+    table = base_ + offset_ + sizeof(header);
+    uint64_t data_bytes = 0;
+    for (size_t c = 0; c < columns; ++c) {
+        uint32_t bytes;
+        std::memcpy(&bytes, table + c * sizeof(uint32_t), sizeof(bytes));
+        if (bytes < header.rows) {
+            throw std::runtime_error("Corrupt recording block: more rows than column bytes");
+        }
+        data_bytes += bytes;
+    }
+    if (data_bytes != header.payload_bytes - columns * sizeof(uint32_t)) {
+        throw std::runtime_error("Corrupt recording block: column sizes do not match payload");
+    }
+    return true;
+}
+
+bool RecordingReader::nextBlock(std::vector<int64_t>& values, size_t& rows) {
+    const size_t columns = layout_.columns();
+    recorder_format::BlockHeader header;
+    const uint8_t* table = nullptr;
+    if (!readBlock(header, table)) return false;
+    
+    const uint8_t* data = table + columns * sizeof(uint32_t);
+    rows = header.rows;
+    values.resize(columns * rows);
+    
+    for (size_t c = 0; c < columns; ++c) {
+        uint32_t bytes;
+        std::memcpy(&bytes, table + c * sizeof(uint32_t), sizeof(bytes));
+        if (!decodeColumn(data, data + bytes, rows, values.data() + c * rows)) {
+            throw std::runtime_error("Corrupt recording block: column overruns its bytes");
+        }
+        data += bytes;
+    }
+    
+    offset_ += sizeof(header) + header.payload_bytes;
+    return true;
+}
+
+bool RecordingReader::nextBlockColumn(size_t column, std::vector<int64_t>& values, size_t& rows) {
+    const size_t columns = layout_.columns();
+    recorder_format::BlockHeader header;
+    const uint8_t* table = nullptr;
+    if (column >= columns || !readBlock(header, table)) return false;
+    
+    const uint8_t* data = table + columns * sizeof(uint32_t);
+    uint32_t bytes = 0;
+    for (size_t c = 0; c <= column; ++c) {
+        data += bytes;
+        std::memcpy(&bytes, table + c * sizeof(uint32_t), sizeof(bytes));
+    }
+    
+    rows = header.rows;
+    values.resize(rows);
+    if (!decodeColumn(data, data + bytes, rows, values.data())) {
+        throw std::runtime_error("Corrupt recording block: column overruns its bytes");
+    }
+    
+    offset_ += sizeof(header) + header.payload_bytes;
+    return true;
+}
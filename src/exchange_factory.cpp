@@ -1,70 +1,22 @@
 #include "exchange_factory.hpp"
-#include "json.hpp"
-#include <fstream>
-#include <iostream>
+#include "venue_registry.hpp"
 
-using json = nlohmann::json;
+std::unique_ptr<IExchangeClient> ExchangeFactory::createCoinbase() {
+    return std::make_unique<venues::VirtualClient<venues::Coinbase>>();
+}
+
+std::unique_ptr<IExchangeClient> ExchangeFactory::createGemini() {
+    return std::make_unique<venues::VirtualClient<venues::Gemini>>();
+}
 
+// Same venue selection as the aggregator's static registry, behind the
+// virtual interface
 std::vector<std::unique_ptr<IExchangeClient>> ExchangeFactory::createFromConfig(
     const std::string& config_path) {
     
     std::vector<std::unique_ptr<IExchangeClient>> clients;
-    
-    // If no config file, use defaults
-    if (config_path.empty()) {
-        clients.push_back(createCoinbase());
-        clients.push_back(createGemini());
-        return clients;
+    for (const auto& venue : venues::Registry::selectFromConfig(config_path)) {
+        clients.push_back(venues::Registry::makeVirtual(venue));
     }
-    
-    try {
-        std::ifstream file(config_path);
-        if (!file.is_open()) {
-            std::cerr << "Warning: Could not open config file: " << config_path << "\n";
-            std::cerr << "Using default exchanges (Coinbase, Gemini)\n";
-            clients.push_back(createCoinbase());
-            clients.push_back(createGemini());
-            return clients;
-        }
-        
-        json config;
-        file >> config;
-        
-        if (!config.contains("exchanges")) {
-            throw std::runtime_error("Config missing 'exchanges' array");
-        }
-        
-        for (const auto& exchange : config["exchanges"]) {
-            if (!exchange["enabled"].get<bool>()) {
-                continue;
-            }
-            
-            std::string id = exchange["id"].get<std::string>();
-            
-            if (id == "coinbase") {
-                clients.push_back(createCoinbase());
-            } else if (id == "gemini") {
-                clients.push_back(createGemini());
-            }
-            // Add more exchanges here as they're implemented
-            // else if (id == "binance") {
-            //     clients.push_back(createBinance());
-            // }
-        }
-        
-        if (clients.empty()) {
-            std::cerr << "Warning: No enabled exchanges found in config\n";
-            std::cerr << "Using default exchanges (Coinbase, Gemini)\n";
-            clients.push_back(createCoinbase());
-            clients.push_back(createGemini());
-        }
-        
-    } catch (const std::exception& e) {
-        std::cerr << "Error parsing config: " << e.what() << "\n";
-        std::cerr << "Using default exchanges (Coinbase, Gemini)\n";
-        clients.push_back(createCoinbase());
-        clients.push_back(createGemini());
-    }
-    
     return clients;
 }
@@ -0,0 +1,269 @@
+#include "fetch_scheduler.hpp"
+#include "json.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr double kLatencySmoothing = 0.2;  // EWMA weight of the newest sample
+constexpr double kNoData = 1e12;           // Sorts venues without a book first
+
+double seconds(std::chrono::steady_clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+}
+
+std::chrono::steady_clock::duration fromSeconds(double s) {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(s));
+}
+
+}  // namespace
+
+VenueBudget SchedulerConfig::budgetFor(Exchange exchange) const {
+    auto it = budgets.find(exchange);
+    return it != budgets.end() ? it->second : VenueBudget{};
+}
+
+SchedulerConfig SchedulerConfig::load(const std::string& config_path) {
+    SchedulerConfig config;
+    if (config_path.empty()) {
+        return config;
+    }
+    
+    try {
+        std::ifstream file(config_path);
+        if (!file.is_open()) {
+            return config;
+        }
+        
+        json root;
+        file >> root;
+        if (root.contains("scheduler")) {
+            const auto& scheduler = root["scheduler"];
+            config.utilisation = std::clamp(scheduler.value("utilisation", 0.8), 0.05, 1.0);
+            config.max_in_flight = scheduler.value("max_in_flight", 0u);
+        }
+        
+        for (const auto& exchange : root.value("exchanges", json::array())) {
+            Exchange id;
+            if (!exchangeFromId(exchange.value("id", ""), id) || !exchange.contains("rate_limits")) {
+                continue;
+            }
+            const auto& limits = exchange["rate_limits"];
+            VenueBudget budget;
+            budget.requests_per_second = limits.value("requests_per_second", budget.requests_per_second);
+            budget.burst_limit = limits.value("burst_limit", budget.burst_limit);
+            budget.weight_limit = limits.value("weight_limit", budget.weight_limit);
+            budget.request_weight = limits.value("request_weight", budget.request_weight);
+            config.budgets[id] = budget;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Warning: Invalid scheduler config: " << e.what() << "\n";
+        config = SchedulerConfig{};
+    }
+    
+    return config;
+}
+
+void FetchScheduler::TokenBucket::refill(Clock::time_point now) {
+    if (capacity > 0 && now > updated) {
+        tokens = std::min(capacity, tokens + rate * seconds(now - updated));
+    }
+    updated = std::max(updated, now);
+}
+
+FetchScheduler::Clock::time_point FetchScheduler::TokenBucket::availableAt(double n) const {
+    if (has(n)) {
+        return updated;
+    }
+    return updated + fromSeconds((n - tokens) / rate);
+}
+
+FetchScheduler::FetchScheduler(double utilisation, size_t max_in_flight)
+    : utilisation_(utilisation), max_in_flight_(max_in_flight) {}
+
+size_t FetchScheduler::addVenue(std::string name, const VenueBudget& budget, Clock::time_point now) {
+    Venue venue;
+    venue.name = std::move(name);
+    venue.weight = std::max(budget.request_weight, 0.0);
+    
+    // Sustained rate: the tighter of the request and weight budgets, less headroom
+    double rate = std::max(budget.requests_per_second, 1e-3);
+    if (budget.weight_limit > 0 && venue.weight > 0) {
+        rate = std::min(rate, budget.weight_limit / 60.0 / venue.weight);
+    }
+    venue.interval = fromSeconds(1.0 / (rate * utilisation_));
+    
+    // The buckets enforce the published limits themselves; headroom only
+    // applies to the cadence above
+    venue.requests.capacity = std::max(budget.burst_limit, 1.0);
+    venue.requests.rate = std::max(budget.requests_per_second, 1e-3);
+    venue.requests.tokens = venue.requests.capacity;
+    venue.requests.updated = now;
+    if (budget.weight_limit > 0) {
+        venue.weights.capacity = budget.weight_limit;
+        venue.weights.rate = budget.weight_limit / 60.0;
+        venue.weights.tokens = budget.weight_limit;
+        venue.weights.updated = now;
+    }
+    
+    venue.next_due = now;
+    venues_.push_back(std::move(venue));
+    return venues_.size() - 1;
+}
+
+bool FetchScheduler::eligible(Venue& venue, Clock::time_point now) {
+    if (venue.in_flight) {
+        return false;
+    }
+    venue.requests.refill(now);
+    venue.weights.refill(now);
+    return venue.requests.has(1.0) && venue.weights.has(venue.weight) &&
+           (venue.retry_now || now >= venue.next_due);
+}
+
+double FetchScheduler::projectedAge(const Venue& venue, Clock::time_point now) const {
+    if (!venue.has_data) {
+        return kNoData;
+    }
+    return seconds(now - venue.data_time) + venue.latency_s;
+}
+
+std::vector<size_t> FetchScheduler::due(Clock::time_point now) {
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < venues_.size(); ++i) {
+        if (eligible(venues_[i], now)) {
+            ready.push_back(i);
+        }
+    }
+    
+    // Stalest on arrival first, so a capped budget goes where it matters most
+    std::sort(ready.begin(), ready.end(), [this, now](size_t a, size_t b) {
+        return projectedAge(venues_[a], now) > projectedAge(venues_[b], now);
+    });
+    if (max_in_flight_ > 0) {
+        ready.resize(std::min(ready.size(), max_in_flight_ - std::min(max_in_flight_, in_flight_)));
+    }
+    
+    for (size_t i : ready) {
+        Venue& venue = venues_[i];
+        venue.requests.take(1.0);
+        venue.weights.take(venue.weight);
+        venue.in_flight = true;
+        venue.retry_now = false;
+        venue.next_due = now + venue.interval;
+        ++venue.sent;
+        ++in_flight_;
+    }
+    return ready;
+}
+
+FetchScheduler::Clock::time_point FetchScheduler::nextWakeup(Clock::time_point now) const {
+    auto wakeup = Clock::time_point::max();
+    if (max_in_flight_ > 0 && in_flight_ >= max_in_flight_) {
+        return wakeup;
+    }
+    for (const auto& venue : venues_) {
+        if (venue.in_flight) {
+            continue;
+        }
+        auto at = std::max({venue.retry_now ? now : venue.next_due,
+                            venue.requests.availableAt(1.0),
+                            venue.weights.availableAt(venue.weight)});
+        wakeup = std::min(wakeup, std::max(at, now));
+    }
+    return wakeup;
+}
+
+void FetchScheduler::onComplete(size_t index, Clock::time_point sent, Clock::time_point received,
+                                bool success) {
+    Venue& venue = venues_[index];
+    if (venue.in_flight) {
+        venue.in_flight = false;
+        --in_flight_;
+    }
+    ++venue.completed;
+    
+    if (!success) {
+        // One immediate retry out of the burst allowance, then back to cadence
+        venue.retry_now = venue.consecutive_failures == 0;
+        ++venue.consecutive_failures;
+        ++venue.failures;
+        return;
+    }
+    venue.consecutive_failures = 0;
+    
+    double latency = seconds(received - sent);
+    venue.latency_s = !venue.has_data
+        ? latency
+        : venue.latency_s + kLatencySmoothing * (latency - venue.latency_s);
+    
+    if (venue.has_data) {
+        // Age rises linearly between refreshes: integrate the sawtooth
+        double before = seconds(venue.last_refresh - venue.data_time);
+        double peak = seconds(received - venue.data_time);
+        double span = seconds(received - venue.last_refresh);
+        venue.age_integral_s2 += 0.5 * (before + peak) * span;
+        venue.covered_s += span;
+        venue.worst_age_s = std::max(venue.worst_age_s, peak);
+    }
+    
+    // The venue built the book somewhere inside the round trip; assume the middle
+    venue.data_time = sent + (received - sent) / 2;
+    venue.last_refresh = received;
+    venue.has_data = true;
+}
+
+FetchScheduler::VenueMetrics FetchScheduler::metrics(size_t index, Clock::time_point now) const {
+    const Venue& venue = venues_[index];
+    VenueMetrics m;
+    m.name = venue.name;
+    m.interval_ms = seconds(venue.interval) * 1000.0;
+    m.latency_ms = venue.latency_s * 1000.0;
+    m.requests = venue.sent;
+    m.failures = venue.failures;
+    m.age_ms = -1;
+    
+    if (venue.has_data) {
+        double before = seconds(venue.last_refresh - venue.data_time);
+        double current = seconds(now - venue.data_time);
+        double span = seconds(now - venue.last_refresh);
+        double integral = venue.age_integral_s2 + 0.5 * (before + current) * span;
+        double covered = venue.covered_s + span;
+        
+        m.age_ms = current * 1000.0;
+        m.mean_age_ms = (covered > 0 ? integral / covered : current) * 1000.0;
+        m.worst_age_ms = std::max(venue.worst_age_s, current) * 1000.0;
+    }
+    return m;
+}
+
+double FetchScheduler::worstAgeMs(Clock::time_point now) const {
+    double worst = 0;
+    for (size_t i = 0; i < venues_.size(); ++i) {
+        worst = std::max(worst, metrics(i, now).worst_age_ms);
+    }
+    return worst;
+}
+
+void FetchScheduler::report(std::ostream& out, Clock::time_point now) const {
+    out << "Book age (ms)   interval  latency     mean    worst  requests  failures\n";
+    for (size_t i = 0; i < venues_.size(); ++i) {
+        VenueMetrics m = metrics(i, now);
+        out << "  " << std::left << std::setw(12) << m.name << std::right << std::fixed
+            << std::setprecision(0)
+            << std::setw(10) << m.interval_ms
+            << std::setw(9) << m.latency_ms;
+        if (m.age_ms < 0) {
+            out << std::setw(9) << "-" << std::setw(9) << "-";  // No book yet
+        } else {
+            out << std::setw(9) << m.mean_age_ms << std::setw(9) << m.worst_age_ms;
+        }
+        out << std::setw(10) << m.requests
+            << std::setw(10) << m.failures << "\n";
+    }
+}
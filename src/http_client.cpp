@@ -1,7 +1,30 @@
 #include "http_client.hpp"
+#include "content_hash.hpp"
 #include <stdexcept>
 #include <thread>    // ADD THIS
 #include <chrono>    // ADD THIS
+#include <cctype>
+#include <strings.h>
+
+namespace {
+
+ErrorCode classifyCurl(CURLcode code) noexcept {
+    switch (code) {
+        case CURLE_OPERATION_TIMEDOUT: return ErrorCode::TIMEOUT;
+        case CURLE_COULDNT_RESOLVE_HOST:
+        case CURLE_COULDNT_RESOLVE_PROXY: return ErrorCode::DNS_FAILURE;
+        case CURLE_COULDNT_CONNECT: return ErrorCode::CONNECT_FAILED;
+        default: return ErrorCode::NETWORK_ERROR;
+    }
+}
+
+ErrorCode classifyStatus(long status) noexcept {
+    if (status == 429) return ErrorCode::RATE_LIMITED;
+    if (status >= 500) return ErrorCode::SERVER_ERROR;
+    return ErrorCode::HTTP_STATUS;
+}
+
+}  // namespace
 
 size_t HTTPClient::writeCallback(void* contents, size_t size, size_t nmemb, void* userp) {
     size_t total_size = size * nmemb;
@@ -9,6 +32,41 @@ size_t HTTPClient::writeCallback(void* contents, size_t size, size_t nmemb, void
     return total_size;
 }
 
+// Captures ETag / Last-Modified from the response headers
+size_t HTTPClient::headerCallback(char* buffer, size_t size, size_t nitems, void* userp) {
+    size_t total_size = size * nitems;
+    auto* self = static_cast<HTTPClient*>(userp);
+    std::string_view line(buffer, total_size);
+    
+    // A new status line means a new response (redirect, 100-continue)
+    if (line.rfind("HTTP/", 0) == 0) {
+        self->etag_.clear();
+        self->last_modified_.clear();
+        return total_size;
+    }
+    
+    size_t colon = line.find(':');
+    if (colon == std::string_view::npos) {
+        return total_size;
+    }
+    
+    std::string_view name = line.substr(0, colon);
+    std::string_view value = line.substr(colon + 1);
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.front()))) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.back()))) {
+        value.remove_suffix(1);
+    }
+    
+    if (name.size() == 4 && strncasecmp(name.data(), "etag", 4) == 0) {
+        self->etag_.assign(value);
+    } else if (name.size() == 13 && strncasecmp(name.data(), "last-modified", 13) == 0) {
+        self->last_modified_.assign(value);
+    }
+    return total_size;
+}
+
 HTTPClient::HTTPClient() : curl_(curl_easy_init()) {
     if (!curl_) {
         throw std::runtime_error("Failed to initialize CURL");
@@ -17,6 +75,8 @@ HTTPClient::HTTPClient() : curl_(curl_easy_init()) {
     // Set common options for low-latency
     curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, writeCallback);
     curl_easy_setopt(curl_, CURLOPT_WRITEDATA, &response_buffer_);
+    curl_easy_setopt(curl_, CURLOPT_HEADERFUNCTION, headerCallback);
+    curl_easy_setopt(curl_, CURLOPT_HEADERDATA, this);
     curl_easy_setopt(curl_, CURLOPT_USERAGENT, "OrderBookAggregator/2.0");
     curl_easy_setopt(curl_, CURLOPT_TCP_NODELAY, 1L);  // Disable Nagle
     curl_easy_setopt(curl_, CURLOPT_NOSIGNAL, 1L);     // Thread-safe
@@ -29,9 +89,65 @@ HTTPClient::~HTTPClient() {
     }
 }
 
-std::string HTTPClient::get(const std::string& url, uint32_t timeout_ms) {
+Result<std::string> HTTPClient::get(const std::string& url, uint32_t timeout_ms) {
+    Result<long> status = perform(url, timeout_ms);
+    if (!status) {
+        return Result<std::string>::failure(status.error(), status.detail());
+    }
+    if (*status != 200) {
+        return Result<std::string>::failure(classifyStatus(*status), static_cast<int32_t>(*status));
+    }
+    return response_buffer_;
+}
+
+Result<FetchOutcome> HTTPClient::getIfChanged(const std::string& url, uint32_t timeout_ms,
+                                              ConditionalState& state, std::string& body) {
+    using Outcome = Result<FetchOutcome>;
+    
+    struct curl_slist* headers = nullptr;
+    if (!state.etag.empty()) {
+        headers = curl_slist_append(headers, ("If-None-Match: " + state.etag).c_str());
+    }
+    if (!state.last_modified.empty()) {
+        headers = curl_slist_append(headers, ("If-Modified-Since: " + state.last_modified).c_str());
+    }
+    curl_easy_setopt(curl_, CURLOPT_HTTPHEADER, headers);
+    
+    Result<long> status = perform(url, timeout_ms);
+    
+    curl_easy_setopt(curl_, CURLOPT_HTTPHEADER, nullptr);
+    curl_slist_free_all(headers);
+    
+    if (!status) {
+        return Outcome::failure(status.error(), status.detail());
+    }
+    if (*status == 304 && state.has_body) {
+        return FetchOutcome::NOT_MODIFIED;
+    }
+    if (*status != 200) {
+        return Outcome::failure(classifyStatus(*status), static_cast<int32_t>(*status));
+    }
+    
+    // Only echo validators the venue actually gave us
+    state.etag = etag_;
+    state.last_modified = last_modified_;
+    
+    uint64_t hash = content_hash::xxh64(response_buffer_);
+    if (state.has_body && hash == state.body_hash) {
+        return FetchOutcome::UNCHANGED_BODY;
+    }
+    
+    state.body_hash = hash;
+    state.has_body = true;
+    body.swap(response_buffer_);
+    return FetchOutcome::CHANGED;
+}
+
+Result<long> HTTPClient::perform(const std::string& url, uint32_t timeout_ms) {
     response_buffer_.clear();
     response_buffer_.reserve(65536);
+    etag_.clear();
+    last_modified_.clear();
     
     curl_easy_setopt(curl_, CURLOPT_URL, url.c_str());
     curl_easy_setopt(curl_, CURLOPT_TIMEOUT_MS, timeout_ms);
@@ -44,7 +160,9 @@ std::string HTTPClient::get(const std::string& url, uint32_t timeout_ms) {
         CURLcode res = curl_easy_perform(curl_);
         
         if (res == CURLE_OK) {
-            return response_buffer_;
+            long status = 0;
+            curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &status);
+            return status;
         }
         
         // If timeout, retry with exponential backoff
@@ -63,11 +181,11 @@ std::string HTTPClient::get(const std::string& url, uint32_t timeout_ms) {
             }
         }
         
-        // Non-timeout error
-        throw std::runtime_error(std::string("CURL error: ") + curl_easy_strerror(res));
+        // Non-timeout error, or out of retries
+        return Result<long>::failure(classifyCurl(res), static_cast<int32_t>(res));
     }
     
-    throw std::runtime_error("Max retries exceeded");
+    return Result<long>::failure(ErrorCode::TIMEOUT, CURLE_OPERATION_TIMEDOUT);
     // ADD RETRY LOGIC - END HERE
 }
 
@@ -93,3 +211,27 @@ void HTTPClientPool::release(std::unique_ptr<HTTPClient> client) {
         pool_.push_back(std::move(client));
     }
 }
+
+Result<FetchOutcome> ConditionalFetcher::fetch(uint32_t timeout_ms, std::string& body) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto client = HTTPClientPool::instance().acquire();
+    Result<FetchOutcome> outcome = client->getIfChanged(url_, timeout_ms, state_, body);
+    HTTPClientPool::instance().release(std::move(client));
+    if (outcome) {
+        stats_.record(*outcome);
+    } else {
+        stats_.recordFailure();
+    }
+    return outcome;
+}
+
+void ConditionalFetcher::invalidate() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    state_ = ConditionalState{};
+}
+
+void ConditionalFetcher::setUrl(std::string url) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    url_ = std::move(url);
+    state_ = ConditionalState{};
+}
@@ -0,0 +1,123 @@
+#include "huge_page_arena.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <sys/mman.h>
+
+namespace {
+
+size_t roundUp(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+}  // namespace
+
+HugePageArena::~HugePageArena() {
+    for (const Chunk& chunk : chunks_) {
+        unmap(chunk);
+    }
+}
+
+void* HugePageArena::allocate(size_t bytes, size_t align) {
+    if (align > kHugePageSize || (align & (align - 1)) != 0) {
+        throw std::bad_alloc();
+    }
+    size_t start = chunks_.empty() ? 0 : roundUp(offset_, align);
+    if (chunks_.empty() || start + bytes > chunks_.back().size) {
+        // A fresh chunk big enough for a whole previous generation, so a
+        // book rebuilt after reset() lands in a single mapping
+        chunks_.push_back(map(std::max(bytes, high_water_)));
+        start = 0;
+    }
+    offset_ = start + bytes;
+    generation_ += bytes;
+    high_water_ = std::max(high_water_, generation_);
+    return static_cast<char*>(chunks_.back().base) + start;
+}
+
+void HugePageArena::reset() noexcept {
+    if (chunks_.size() > 1) {
+        auto largest = std::max_element(chunks_.begin(), chunks_.end(),
+            [](const Chunk& a, const Chunk& b) { return a.size < b.size; });
+        Chunk keep = *largest;
+        for (const Chunk& chunk : chunks_) {
+            if (chunk.base != keep.base) unmap(chunk);
+        }
+        chunks_.assign(1, keep);
+        // Too small for the last generation: let the next allocation map
+        // one that fits rather than spilling into a second chunk again
+        if (keep.size < high_water_) {
+            unmap(keep);
+            chunks_.clear();
+        }
+    }
+    offset_ = 0;
+    generation_ = 0;
+}
+
+size_t HugePageArena::reserved() const noexcept {
+    size_t total = 0;
+    for (const Chunk& chunk : chunks_) total += chunk.size;
+    return total;
+}
+
+HugePageArena::Backing HugePageArena::backing() const noexcept {
+    return chunks_.empty() ? preferred_ : chunks_.back().backing;
+}
+
+const char* HugePageArena::backingName(Backing backing) noexcept {
+    switch (backing) {
+        case Backing::HUGETLB: return "hugetlb";
+        case Backing::TRANSPARENT: return "transparent huge pages";
+        case Backing::SMALL_PAGES: return "4 KB pages";
+    }
+    return "unknown";
+}
+
+HugePageArena::Chunk HugePageArena::map(size_t bytes) const {
+    const size_t size = roundUp(std::max<size_t>(bytes, 1), kHugePageSize);
+
+#ifdef MAP_HUGETLB
+    if (preferred_ == Backing::HUGETLB) {
+        void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (base != MAP_FAILED) {
+            return {base, size, Backing::HUGETLB};
+        }
+    }
+#endif
+
+    // Over-map by one huge page and trim, so the chunk starts on a 2 MB
+    // boundary and THP can back it from the first byte
+    const size_t padded = size + kHugePageSize;
+    void* raw = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+    uintptr_t aligned = roundUp(begin, kHugePageSize);
+    if (aligned > begin) {
+        ::munmap(raw, aligned - begin);
+    }
+    if (begin + padded > aligned + size) {
+        ::munmap(reinterpret_cast<void*>(aligned + size), begin + padded - (aligned + size));
+    }
+    void* base = reinterpret_cast<void*>(aligned);
+
+    Backing backing = Backing::SMALL_PAGES;
+#ifdef MADV_HUGEPAGE
+    if (preferred_ != Backing::SMALL_PAGES && ::madvise(base, size, MADV_HUGEPAGE) == 0) {
+        backing = Backing::TRANSPARENT;
+    }
+#endif
+#ifdef MADV_NOHUGEPAGE
+    if (preferred_ == Backing::SMALL_PAGES) {
+        ::madvise(base, size, MADV_NOHUGEPAGE);  // Keep "always" THP out of the baseline
+    }
+#endif
+    return {base, size, backing};
+}
+
+void HugePageArena::unmap(const Chunk& chunk) noexcept {
+    ::munmap(chunk.base, chunk.size);
+}
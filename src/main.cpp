@@ -5,12 +5,19 @@
 #include <future>
 #include <locale>
 #include <cstring>
+#include <thread>
 #include <curl/curl.h>
 
 #include "order_book.hpp"
-#include "exchange_factory.hpp"
-#include "rate_limiter.hpp"
+#include "book_analytics.hpp"
+#include "venue_registry.hpp"
+#include "fetch_scheduler.hpp"
 #include "price_calculator.hpp"
+#include "quote_cache.hpp"
+#include "thread_runtime.hpp"
+#include "book_recorder.hpp"
+#include "book_checkpoint.hpp"
+#include "book_multicast.hpp"
 
 double parseQuantity(int argc, char* argv[]) {
     double quantity = 10.0;
@@ -52,60 +59,399 @@ std::string formatCurrency(double value) {
     return result;
 }
 
+int parseCycles(int argc, char* argv[]) {
+    int cycles = 1;
+    
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--cycles") == 0 && i + 1 < argc) {
+            try {
+                cycles = std::stoi(argv[i + 1]);
+                if (cycles <= 0) {
+                    std::cerr << "Error: Cycles must be positive\n";
+                    return -1;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid cycles - " << e.what() << "\n";
+                return -1;
+            }
+            break;
+        }
+    }
+    
+    return cycles;
+}
+
+// Milliseconds between checkpoint saves while polling
+int parseCheckpointInterval(int argc, char* argv[]) {
+    int interval_ms = 1000;
+    
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--checkpoint-interval") == 0 && i + 1 < argc) {
+            try {
+                interval_ms = std::stoi(argv[i + 1]);
+                if (interval_ms <= 0) {
+                    std::cerr << "Error: Checkpoint interval must be positive\n";
+                    return -1;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid checkpoint interval - " << e.what() << "\n";
+                return -1;
+            }
+            break;
+        }
+    }
+    
+    return interval_ms;
+}
+
+std::string parseStringOption(int argc, char* argv[], const char* name) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0 && i + 1 < argc) {
+            return argv[i + 1];
+        }
+    }
+    return "";
+}
+
+bool hasFlag(int argc, char* argv[], const char* name) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// One line per venue the order would be sent to
+void printAllocation(const RoutedExecution& routed) {
+    for (size_t v = 0; v < kRoutedVenues; ++v) {
+        const VenueFill& fill = routed.venues[v];
+        if (fill.quantity == 0) continue;
+        std::cout << "  " << std::left << std::setw(10) << exchangeName(static_cast<Exchange>(v)) << std::right
+                  << std::setprecision(8) << fill.quantity / static_cast<double>(QUANTITY_SCALE) << " BTC"
+                  << std::setprecision(2)
+                  << "  $" << formatCurrency(fill.notional / static_cast<double>(PRICE_SCALE))
+                  << "  fee $" << formatCurrency(fill.fee / static_cast<double>(PRICE_SCALE))
+                  << "  worst $" << formatCurrency(fill.worst_price / static_cast<double>(PRICE_SCALE))
+                  << "  " << fill.levels << (fill.levels == 1 ? " level\n" : " levels\n");
+    }
+}
+
+std::string formatBTC(Quantity size) {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(8) << size / static_cast<double>(QUANTITY_SCALE);
+    return ss.str();
+}
+
+// Spread, depth bands and VWAPs as the analytics last published them
+void printLiquidity(const LiquiditySnapshot& snap) {
+    auto dollars = [](double cents) { return "$" + formatCurrency(cents / PRICE_SCALE); };
+    std::cout << "Best bid " << dollars(snap.best_bid) << " (" << exchangeName(snap.best_bid_venue) << ", "
+              << formatBTC(snap.best_bid_size) << " BTC), best ask " << dollars(snap.best_ask)
+              << " (" << exchangeName(snap.best_ask_venue) << ", " << formatBTC(snap.best_ask_size) << " BTC)\n";
+    if (snap.two_sided) {
+        std::cout << "Spread " << dollars(snap.spread) << " (" << std::setprecision(2) << snap.spread_bps
+                  << " bps" << (snap.spread < 0 ? ", crossed across venues" : "") << ")\n";
+    }
+    for (size_t k = 0; k < snap.band_count; ++k) {
+        const auto& band = snap.bands[k];
+        std::cout << "  Within " << std::setw(3) << band.bps << " bps of mid: bid " << formatBTC(band.bid_depth)
+                  << " BTC, ask " << formatBTC(band.ask_depth) << " BTC, imbalance "
+                  << std::showpos << std::setprecision(3) << band.imbalance() << std::noshowpos << "\n";
+    }
+    std::cout << std::setprecision(2);
+    for (size_t k = 0; k < snap.vwap_count; ++k) {
+        const auto& vwap = snap.vwaps[k];
+        auto price = [&](const ExecutionResult& result) {
+            return result.fully_filled ? dollars(LiquiditySnapshot::VwapBand::vwap(result)) : std::string("n/a");
+        };
+        std::cout << "  VWAP for " << vwap.size / static_cast<double>(QUANTITY_SCALE) << " BTC: buy "
+                  << price(vwap.buy) << ", sell " << price(vwap.sell) << "\n";
+    }
+}
+
+int64_t nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Runs func on a runtime thread and waits, or inline when the runtime is off
+template<typename Func>
+auto runOn(PinnedWorker* worker, Func&& func) -> decltype(func()) {
+    if (worker) {
+        return worker->submit(std::forward<Func>(func)).get();
+    }
+    return func();
+}
+
 int main(int argc, char* argv[]) {
     double quantity = parseQuantity(argc, argv);
     if (quantity < 0) return 1;
     
+    // Responses to collect from every venue; faster venues are polled more
+    // often in the meantime, as their rate budgets allow
+    int cycles = parseCycles(argc, argv);
+    if (cycles < 0) return 1;
+    int checkpoint_interval_ms = parseCheckpointInterval(argc, argv);
+    if (checkpoint_interval_ms < 0) return 1;
+    
     Quantity quantity_fixed = static_cast<Quantity>(quantity * QUANTITY_SCALE);
     
     curl_global_init(CURL_GLOBAL_DEFAULT);
     
+    std::string config_path = parseStringOption(argc, argv, "--config");
+    std::string record_path = parseStringOption(argc, argv, "--record");
+    std::string checkpoint_path = parseStringOption(argc, argv, "--checkpoint");
+    std::string publish_spec = parseStringOption(argc, argv, "--publish");
+    bool show_routing = hasFlag(argc, argv, "--route");
+    bool show_liquidity = hasFlag(argc, argv, "--analytics");
+    
     try {
-        auto exchanges = ExchangeFactory::createFromConfig("");
+        // Venues are resolved at compile time; config only picks which are polled
+        venues::Registry exchanges;
+        exchanges.activate(venues::Registry::selectFromConfig(config_path));
         
-        std::vector<std::unique_ptr<RateLimiter>> limiters;
-        for (size_t i = 0; i < exchanges.size(); ++i) {
-            limiters.push_back(
-                std::make_unique<RateLimiter>(std::chrono::milliseconds(2000)));
+        // Dedicated-core mode: fixed, named, pinned threads instead of std::async
+        RuntimeConfig runtime_config = RuntimeConfig::load(config_path);
+        std::unique_ptr<ThreadRuntime> runtime;
+        if (runtime_config.enabled) {
+            runtime = std::make_unique<ThreadRuntime>(runtime_config, exchanges.size());
         }
         
-        // Fetch order books in parallel
-        std::vector<std::future<OrderBookSnapshot>> futures;
+        // Each venue is polled on its own cadence from its rate budget
+        SchedulerConfig scheduler_config = SchedulerConfig::load(config_path);
+        FetchScheduler scheduler(scheduler_config.utilisation, scheduler_config.max_in_flight);
         for (size_t i = 0; i < exchanges.size(); ++i) {
-            futures.push_back(limiters[i]->execute([&, i]() {
-                return exchanges[i]->fetchOrderBook();
-            }));
+            scheduler.addVenue(exchanges.name(i),
+                               scheduler_config.budgetFor(exchanges.id(i)),
+                               FetchScheduler::Clock::now());
         }
         
-        // Aggregate order books
         OrderBook aggregated;
         bool has_data = false;
         
-        for (size_t i = 0; i < futures.size(); ++i) {
-            auto snapshot = futures[i].get();
+        // Spread, depth bands and VWAPs kept current as venues update
+        std::unique_ptr<BookAnalytics> analytics;
+        if (show_liquidity) {
+            analytics = std::make_unique<BookAnalytics>(aggregated);
+        }
+        
+        // Per-venue time of the data currently in the book (0 = none), and
+        // whether it came from this run rather than the warm-start checkpoint
+        std::vector<int64_t> venue_timestamps(exchanges.size(), 0);
+        std::vector<bool> venue_fresh(exchanges.size(), false);
+        
+        if (!checkpoint_path.empty()) {
+            auto load_start = std::chrono::steady_clock::now();
+            std::vector<VenueBook> saved;
+            int64_t written_us = 0;
+            if (book_checkpoint::load(checkpoint_path, saved, written_us)) {
+                size_t levels = 0;
+                for (auto& venue : saved) {
+                    for (size_t i = 0; i < exchanges.size(); ++i) {
+                        if (exchanges.id(i) != venue.exchange) continue;
+                        aggregated.replaceExchange(venue.exchange, venue.bids, venue.asks);
+                        venue_timestamps[i] = venue.timestamp_us;
+                        levels += venue.bids.size() + venue.asks.size();
+                        has_data = true;
+                    }
+                }
+                double load_ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - load_start).count();
+                std::cerr << "Warm start: " << levels << " levels from checkpoint in "
+                          << std::fixed << std::setprecision(2) << load_ms << " ms (data "
+                          << (nowMicros() - written_us) / 1000000 << "s old, stale until refreshed)\n";
+            }
+        }
+        
+        // Saved on an interval, and once more at exit, from a background
+        // thread; the loop only copies the book out
+        std::unique_ptr<book_checkpoint::BackgroundWriter> checkpoint;
+        if (!checkpoint_path.empty()) {
+            checkpoint = std::make_unique<book_checkpoint::BackgroundWriter>(checkpoint_path);
+        }
+        const auto checkpoint_interval = std::chrono::milliseconds(checkpoint_interval_ms);
+        auto next_checkpoint = FetchScheduler::Clock::now() + checkpoint_interval;
+        bool checkpoint_dirty = false;
+        auto saveCheckpoint = [&]() {
+            std::vector<std::pair<Exchange, int64_t>> stamps;
+            for (size_t v = 0; v < exchanges.size(); ++v) {
+                if (venue_timestamps[v] != 0) {
+                    stamps.emplace_back(exchanges.id(v), venue_timestamps[v]);
+                }
+            }
+            checkpoint->submit(book_checkpoint::splitByVenue(aggregated, stamps), nowMicros());
+            checkpoint_dirty = false;
+        };
+        
+        // Optional per-cycle columnar history of top-of-book and cost curves
+        std::unique_ptr<BookRecorder> recorder;
+        if (!record_path.empty()) {
+            RecorderLayout layout;
+            for (size_t i = 0; i < exchanges.size(); ++i) {
+                layout.venues.push_back(exchanges.id(i));
+            }
+            recorder = std::make_unique<BookRecorder>(record_path, std::move(layout));
+        }
+        
+        // Optional multicast feed of the consolidated book for other hosts
+        std::unique_ptr<BookMulticastPublisher> publisher;
+        if (!publish_spec.empty()) {
+            publisher = std::make_unique<BookMulticastPublisher>(MulticastEndpoint::parse(publish_spec));
+        }
+        constexpr uint64_t kSnapshotEveryUpdates = 10;  // Bounds how long a late joiner waits
+        constexpr auto kSnapshotInterval = std::chrono::seconds(1);  // ...and at least this often
+        auto next_snapshot = FetchScheduler::Clock::now() + kSnapshotInterval;
+        
+        std::vector<std::future<OrderBookSnapshot>> in_flight(exchanges.size());
+        std::vector<FetchScheduler::Clock::time_point> sent_at(exchanges.size());
+        uint64_t updates = 0;
+        
+        auto finished = [&]() {
+            for (size_t i = 0; i < exchanges.size(); ++i) {
+                if (scheduler.completed(i) < static_cast<uint64_t>(cycles)) return false;
+            }
+            return true;
+        };
+        
+        auto pending = [&]() {
+            for (const auto& future : in_flight) {
+                if (future.valid()) return true;
+            }
+            return false;
+        };
+        
+        while (!finished() || pending()) {
+            auto now = FetchScheduler::Clock::now();
             
-            if (!snapshot.success) {
-                std::cerr << "Warning: " << snapshot.error << "\n";
-                continue;
+            // Launch whatever the scheduler says is due
+            if (!finished()) {
+                for (size_t i : scheduler.due(now)) {
+                    auto fetch = [&, i]() { return exchanges.fetch(i); };
+                    sent_at[i] = now;
+                    in_flight[i] = runtime
+                        ? runtime->network(i).submit(fetch)
+                        : std::async(std::launch::async, fetch);
+                }
             }
             
-            #ifdef DEBUG_ORDERBOOK
-            std::cerr << "\n" << exchanges[i]->getName() << " Order Book:\n";
-            std::cerr << "  Bids: " << snapshot.bids.size() << " levels\n";
-            std::cerr << "  Asks: " << snapshot.asks.size() << " levels\n";
-            if (!snapshot.bids.empty()) {
-                std::cerr << "  Best Bid: $" << std::fixed << std::setprecision(2)
-                         << (snapshot.bids[0].price / static_cast<double>(PRICE_SCALE)) << "\n";
-            }
-            if (!snapshot.asks.empty()) {
-                std::cerr << "  Best Ask: $" << std::fixed << std::setprecision(2)
-                         << (snapshot.asks[0].price / static_cast<double>(PRICE_SCALE)) << "\n";
-            }
-            #endif
+            // Apply completed responses
+            bool progressed = false;
+            for (size_t i = 0; i < in_flight.size(); ++i) {
+                if (!in_flight[i].valid() ||
+                    in_flight[i].wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                    continue;
+                }
+                progressed = true;
+                auto snapshot = in_flight[i].get();
+                scheduler.onComplete(i, sent_at[i], FetchScheduler::Clock::now(), snapshot.success);
+                
+                if (!snapshot.success) {
+                    std::cerr << "Warning: " << exchanges.name(i) << ": "
+                              << errorMessage(snapshot.error);
+                    if (snapshot.error_detail != 0) {
+                        std::cerr << " (" << snapshot.error_detail << ")";
+                    }
+                    std::cerr << "\n";
+                    continue;
+                }
+                
+                has_data = true;
+                venue_timestamps[i] = snapshot.timestamp_us;
+                venue_fresh[i] = true;
+                if (snapshot.unchanged) {
+                    continue;  // Book version stays put, so cached quotes remain valid
+                }
+                
+                #ifdef DEBUG_ORDERBOOK
+                std::cerr << "\n" << exchanges.name(i) << " Order Book:\n";
+                std::cerr << "  Bids: " << snapshot.bids.size() << " levels\n";
+                std::cerr << "  Asks: " << snapshot.asks.size() << " levels\n";
+                if (!snapshot.bids.empty()) {
+                    std::cerr << "  Best Bid: $" << std::fixed << std::setprecision(2)
+                             << (snapshot.bids[0].price / static_cast<double>(PRICE_SCALE)) << "\n";
+                }
+                if (!snapshot.asks.empty()) {
+                    std::cerr << "  Best Ask: $" << std::fixed << std::setprecision(2)
+                             << (snapshot.asks[0].price / static_cast<double>(PRICE_SCALE)) << "\n";
+                }
+                #endif
+                
+                Exchange id = exchanges.id(i);
+                runOn(runtime ? &runtime->book() : nullptr, [&aggregated, id, &snapshot]() {
+                    aggregated.replaceExchange(id, snapshot.bids, snapshot.asks);
+                });
+                
+                if (recorder) {
+                    recorder->recordBook(aggregated, nowMicros());
+                }
+                
+                checkpoint_dirty = true;
+                
+                if (publisher) {
+                    if (updates % kSnapshotEveryUpdates == 0) {
+                        publisher->publishSnapshot(aggregated);
+                        next_snapshot = FetchScheduler::Clock::now() + kSnapshotInterval;
+                    } else {
+                        publisher->publishDelta(aggregated);
+                    }
+                }
+                ++updates;
+            }
             
-            aggregated.mergeBids(snapshot.bids);
-            aggregated.mergeAsks(snapshot.asks);
-            has_data = true;
+            // A quiet or 304-heavy book sends few updates; receivers that
+            // join late or saw a gap still get a snapshot every interval
+            if (publisher && has_data && now >= next_snapshot) {
+                publisher->publishSnapshot(aggregated);
+                next_snapshot = now + kSnapshotInterval;
+            }
+            
+            // A save still writing defers the next one rather than queueing
+            if (checkpoint && checkpoint_dirty && now >= next_checkpoint && !checkpoint->busy()) {
+                saveCheckpoint();
+                next_checkpoint = now + checkpoint_interval;
+            }
+            
+            if (!progressed) {
+                // Responses arrive on other threads; a short nap bounds the
+                // added age without spinning a core
+                auto wakeup = std::min(scheduler.nextWakeup(FetchScheduler::Clock::now()),
+                                       FetchScheduler::Clock::now() + std::chrono::milliseconds(1));
+                std::this_thread::sleep_until(wakeup);
+            }
+        }
+        
+        if (checkpoint && checkpoint_dirty) {
+            saveCheckpoint();
+        }
+        if (recorder) {
+            recorder->flush();
+            if (recorder->failed()) {
+                std::cerr << "Warning: Could not write recording " << record_path << ", only "
+                          << recorder->rowsWritten() << " rows saved\n";
+            }
+        }
+        
+        if (cycles > 1) {
+            for (size_t i = 0; i < exchanges.size(); ++i) {
+                const auto& stats = exchanges.stats(i);
+                std::cerr << exchanges.name(i) << ": "
+                          << stats.changed.load() << " changed, "
+                          << stats.not_modified.load() << " not modified (304), "
+                          << stats.unchanged_body.load() << " identical body, "
+                          << stats.failed.load() << " failed\n";
+            }
+            scheduler.report(std::cerr, FetchScheduler::Clock::now());
+            if (analytics) {
+                std::cerr << "Analytics: " << analytics->snapshot().sequence << " book updates, "
+                          << analytics->rebuilds() << " window rebuilds, "
+                          << analytics->fallbacks() << " column fallbacks\n";
+            }
+            if (checkpoint) {
+                checkpoint->wait();
+                std::cerr << "Checkpoint: " << checkpoint->saved() << " saves, "
+                          << checkpoint->failed() << " failed\n";
+            }
         }
         
         if (!has_data) {
@@ -114,10 +460,9 @@ int main(int argc, char* argv[]) {
             return 1;
         }
         
+        #ifdef DEBUG_ORDERBOOK
         auto bids = aggregated.getBids();
         auto asks = aggregated.getAsks();
-        
-        #ifdef DEBUG_ORDERBOOK
         std::cerr << "\nAggregated Order Book:\n";
         std::cerr << "  Total Bids: " << bids.size() << " levels\n";
         std::cerr << "  Total Asks: " << asks.size() << " levels\n";
@@ -131,25 +476,70 @@ int main(int argc, char* argv[]) {
         }
         #endif
         
-        auto buy_result = PriceCalculator::calculateBuyPrice(asks, quantity_fixed);
-        auto sell_result = PriceCalculator::calculateSellPrice(bids, quantity_fixed);
+        RoutingRules routing_rules = RoutingRules::load(config_path);
+        QuoteCache quotes(aggregated);
+        PinnedWorker* query_thread = runtime ? &runtime->query() : nullptr;
+        
+        // With --route the quote is the routed walk's total, so the price
+        // and its per-venue split come from one walk and always agree
+        RoutedExecution routed_buy;
+        RoutedExecution routed_sell;
+        auto quote = [&](QuoteSide side) -> ExecutionResult {
+            if (!show_routing) {
+                return quotes.quote(side, quantity_fixed);
+            }
+            if (side == QuoteSide::BUY) {
+                routed_buy = PriceCalculator::routeBuy(aggregated.getAsks(), quantity_fixed, routing_rules);
+                return routed_buy.total;
+            }
+            routed_sell = PriceCalculator::routeSell(aggregated.getBids(), quantity_fixed, routing_rules);
+            return routed_sell.total;
+        };
+        auto buy_result = runOn(query_thread, [&]() { return quote(QuoteSide::BUY); });
+        auto sell_result = runOn(query_thread, [&]() { return quote(QuoteSide::SELL); });
+        
+        #ifdef DEBUG_ORDERBOOK
+        std::cerr << "Quote cache: " << quotes.hits() << " hits, "
+                  << quotes.misses() << " misses\n";
+        #endif
+        
+        // Any venue still served from the checkpoint makes the quote stale
+        bool stale = false;
+        for (size_t i = 0; i < exchanges.size(); ++i) {
+            stale |= venue_timestamps[i] != 0 && !venue_fresh[i];
+        }
+        const char* stale_note = stale ? " (stale)" : "";
         
         // Output results
         std::cout << std::fixed << std::setprecision(2);
         
         if (buy_result.fully_filled) {
             std::cout << "To buy " << quantity << " BTC: $"
-                      << formatCurrency(buy_result.getTotalCostUSD()) << "\n";
+                      << formatCurrency(buy_result.getTotalCostUSD()) << stale_note << "\n";
         } else {
             std::cout << "To buy " << quantity << " BTC: Insufficient liquidity\n";
         }
+        if (show_routing) {
+            printAllocation(routed_buy);
+        }
         
         if (sell_result.fully_filled) {
             std::cout << "To sell " << quantity << " BTC: $"
-                      << formatCurrency(sell_result.getTotalCostUSD()) << "\n";
+                      << formatCurrency(sell_result.getTotalCostUSD()) << stale_note << "\n";
         } else {
             std::cout << "To sell " << quantity << " BTC: Insufficient liquidity\n";
         }
+        if (show_routing) {
+            printAllocation(routed_sell);
+        }
+        
+        if (analytics) {
+            printLiquidity(analytics->snapshot());
+        }
+        
+        if (runtime) {
+            runtime->report(std::cerr);
+        }
         
     } catch (const std::exception& e) {
         std::cerr << "Fatal error: " << e.what() << "\n";
@@ -0,0 +1,467 @@
+#include "mock_exchange.hpp"
+#include "json.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr double kZ99 = 2.3263478740408408;  // Standard normal 99th percentile
+constexpr Price kBaseMid = 50000 * PRICE_SCALE;
+constexpr Price kHalfSpread = 5 * PRICE_SCALE;  // Wide enough that venue mids never cross
+constexpr Price kVenueMidStep = 137;
+constexpr const char* kBookTimestamp = "1700000000";
+constexpr const char* kKrakenSuffix = ",1700000000";  // Per-level timestamp
+
+const char* configId(Exchange venue) noexcept {
+    switch (venue) {
+        case Exchange::COINBASE: return "coinbase";
+        case Exchange::GEMINI: return "gemini";
+        case Exchange::BINANCE: return "binance";
+        case Exchange::KRAKEN: return "kraken";
+        default: return "unknown";
+    }
+}
+
+// Fixed-point back to the decimal strings venues send
+void appendPrice(std::string& out, Price price) {
+    char buf[32];
+    int n = std::snprintf(buf, sizeof(buf), "%lld.%02lld",
+                          static_cast<long long>(price / PRICE_SCALE),
+                          static_cast<long long>(price % PRICE_SCALE));
+    out.append(buf, static_cast<size_t>(n));
+}
+
+void appendQuantity(std::string& out, Quantity size) {
+    char buf[32];
+    int n = std::snprintf(buf, sizeof(buf), "%lld.%08lld",
+                          static_cast<long long>(size / QUANTITY_SCALE),
+                          static_cast<long long>(size % QUANTITY_SCALE));
+    out.append(buf, static_cast<size_t>(n));
+}
+
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Value of a request header, matched case-insensitively; empty if absent
+std::string headerValue(const std::string& request, const char* name) {
+    size_t name_len = std::strlen(name);
+    size_t pos = request.find("\r\n");
+    while (pos != std::string::npos && pos + 2 < request.size()) {
+        size_t line = pos + 2;
+        size_t end = request.find("\r\n", line);
+        if (end == std::string::npos || end == line) break;
+        if (end - line > name_len && request[line + name_len] == ':' &&
+            ::strncasecmp(request.c_str() + line, name, name_len) == 0) {
+            size_t value = request.find_first_not_of(' ', line + name_len + 1);
+            return value < end ? request.substr(value, end - value) : std::string();
+        }
+        pos = end;
+    }
+    return std::string();
+}
+
+std::string response(const char* status, const char* content_type,
+                     const std::string& etag, const std::string& body) {
+    std::string out;
+    out.reserve(body.size() + 160);
+    out += "HTTP/1.1 ";
+    out += status;
+    out += "\r\nContent-Type: ";
+    out += content_type;
+    out += "\r\nContent-Length: ";
+    out += std::to_string(body.size());
+    if (!etag.empty()) {
+        out += "\r\nETag: ";
+        out += etag;
+    }
+    out += "\r\nConnection: keep-alive\r\n\r\n";
+    out += body;
+    return out;
+}
+
+}  // namespace
+
+double LatencyModel::sampleMs(std::mt19937_64& rng) const {
+    if (median_ms <= 0.0) {
+        return 0.0;
+    }
+    if (p99_ms <= median_ms) {
+        return median_ms;
+    }
+    double sigma = std::log(p99_ms / median_ms) / kZ99;
+    std::lognormal_distribution<double> dist(std::log(median_ms), sigma);
+    return dist(rng);
+}
+
+struct MockExchangeServer::VenueBook {
+    MockVenueConfig config;
+    std::mutex mutex;
+    std::mt19937_64 rng;
+    std::vector<std::pair<Price, Quantity>> bids;  // Best first
+    std::vector<std::pair<Price, Quantity>> asks;
+    uint64_t version = 1;
+    uint64_t rendered_version = 0;
+    std::string body;
+    double churn_carry = 0.0;
+    
+    VenueBook(MockVenueConfig venue_config, uint64_t seed, size_t index)
+        : config(std::move(venue_config)), rng(seed + index * 7919) {
+        if (!config.fixture_path.empty()) {
+            std::ifstream file(config.fixture_path, std::ios::binary);
+            if (!file.is_open()) {
+                throw std::runtime_error("Could not open fixture: " + config.fixture_path);
+            }
+            std::ostringstream contents;
+            contents << file.rdbuf();
+            body = contents.str();
+            rendered_version = version;
+            return;
+        }
+    
+        // Venues quote slightly different mids so the aggregate interleaves
+        Price mid = kBaseMid + static_cast<Price>(index) * kVenueMidStep;
+        bids.reserve(config.depth);
+        asks.reserve(config.depth);
+        for (size_t i = 0; i < config.depth; ++i) {
+            bids.emplace_back(mid - kHalfSpread - static_cast<Price>(i), randomSize());
+            asks.emplace_back(mid + kHalfSpread + static_cast<Price>(i), randomSize());
+        }
+    }
+    
+    Quantity randomSize() {
+        std::uniform_int_distribution<Quantity> dist(QUANTITY_SCALE / 1000, 2 * QUANTITY_SCALE);
+        return dist(rng);
+    }
+    
+    // Resizes churn * (bids + asks) levels, carrying the fraction over so
+    // low churn rates still change the book every few requests
+    void churn() {
+        if (config.churn <= 0.0 || bids.empty()) {
+            return;
+        }
+        churn_carry += config.churn * static_cast<double>(bids.size() + asks.size());
+        size_t changes = static_cast<size_t>(churn_carry);
+        churn_carry -= static_cast<double>(changes);
+        std::uniform_int_distribution<size_t> pick(0, bids.size() + asks.size() - 1);
+        for (size_t i = 0; i < changes; ++i) {
+            size_t level = pick(rng);
+            auto& side = level < bids.size() ? bids : asks;
+            side[level < bids.size() ? level : level - bids.size()].second = randomSize();
+        }
+        if (changes > 0) {
+            ++version;
+        }
+    }
+    
+    const std::string& render() {
+        if (rendered_version == version) {
+            return body;
+        }
+        body.clear();
+        body.reserve(64 * (bids.size() + asks.size()) + 128);
+        switch (config.venue) {
+            case Exchange::GEMINI:
+                body += "{\"bids\":";
+                renderObjects(bids);
+                body += ",\"asks\":";
+                renderObjects(asks);
+                body += "}";
+                break;
+            case Exchange::BINANCE:
+                body += "{\"lastUpdateId\":" + std::to_string(version) + ",\"bids\":";
+                renderArrays(bids, "");
+                body += ",\"asks\":";
+                renderArrays(asks, "");
+                body += "}";
+                break;
+            case Exchange::KRAKEN:
+                body += "{\"error\":[],\"result\":{\"XXBTZUSD\":{\"asks\":";
+                renderArrays(asks, kKrakenSuffix);
+                body += ",\"bids\":";
+                renderArrays(bids, kKrakenSuffix);
+                body += "}}}";
+                break;
+            default:
+                body += "{\"bids\":";
+                renderArrays(bids, ",1");
+                body += ",\"asks\":";
+                renderArrays(asks, ",1");
+                body += ",\"sequence\":" + std::to_string(version) + "}";
+                break;
+        }
+        rendered_version = version;
+        return body;
+    }
+    
+    // [["price","size"<suffix>], ...]
+    void renderArrays(const std::vector<std::pair<Price, Quantity>>& side, const char* suffix) {
+        body += '[';
+        for (size_t i = 0; i < side.size(); ++i) {
+            body += i ? ",[\"" : "[\"";
+            appendPrice(body, side[i].first);
+            body += "\",\"";
+            appendQuantity(body, side[i].second);
+            body += '"';
+            body += suffix;
+            body += ']';
+        }
+        body += ']';
+    }
+    
+    // [{"price":"...","amount":"...","timestamp":"..."}, ...]
+    void renderObjects(const std::vector<std::pair<Price, Quantity>>& side) {
+        body += '[';
+        for (size_t i = 0; i < side.size(); ++i) {
+            body += i ? ",{\"price\":\"" : "{\"price\":\"";
+            appendPrice(body, side[i].first);
+            body += "\",\"amount\":\"";
+            appendQuantity(body, side[i].second);
+            body += "\",\"timestamp\":\"";
+            body += kBookTimestamp;
+            body += "\"}";
+        }
+        body += ']';
+    }
+};
+
+struct MockExchangeServer::Connection {
+    int fd = -1;
+    std::thread thread;
+    std::atomic<bool> done{false};
+};
+
+MockExchangeServer::MockExchangeServer(MockServerConfig config) : config_(std::move(config)) {
+    for (size_t i = 0; i < config_.venues.size(); ++i) {
+        books_.push_back(std::make_unique<VenueBook>(config_.venues[i], config_.seed, i));
+    }
+    
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        throw std::runtime_error(std::string("Failed to create mock exchange socket: ") + std::strerror(errno));
+    }
+    int reuse = 1;
+    ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config_.port);
+    if (::inet_pton(AF_INET, config_.bind_addr.c_str(), &addr.sin_addr) != 1) {
+        ::close(listen_fd_);
+        throw std::runtime_error("Invalid IPv4 address: " + config_.bind_addr);
+    }
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listen_fd_, 64) != 0) {
+        std::string reason = std::strerror(errno);
+        ::close(listen_fd_);
+        throw std::runtime_error("Failed to listen on " + config_.bind_addr + ":" +
+                                 std::to_string(config_.port) + ": " + reason);
+    }
+    
+    socklen_t len = sizeof(addr);
+    ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+    port_ = ntohs(addr.sin_port);
+    
+    running_ = true;
+    acceptor_ = std::thread([this] { acceptLoop(); });
+}
+
+MockExchangeServer::~MockExchangeServer() {
+    stop();
+}
+
+void MockExchangeServer::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    ::shutdown(listen_fd_, SHUT_RDWR);  // Wakes accept()
+    if (acceptor_.joinable()) {
+        acceptor_.join();
+    }
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+    
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    for (auto& connection : connections_) {
+        ::shutdown(connection->fd, SHUT_RDWR);
+    }
+    for (auto& connection : connections_) {
+        connection->thread.join();
+        ::close(connection->fd);
+    }
+    connections_.clear();
+}
+
+const char* MockExchangeServer::pathFor(Exchange venue) noexcept {
+    switch (venue) {
+        case Exchange::COINBASE: return "/products/BTC-USD/book?level=2";
+        case Exchange::GEMINI: return "/v1/book/BTCUSD";
+        case Exchange::BINANCE: return "/api/v3/depth?symbol=BTCUSDT&limit=1000";
+        case Exchange::KRAKEN: return "/0/public/Depth?pair=XXBTZUSD&count=500";
+        default: return "";
+    }
+}
+
+std::string MockExchangeServer::urlFor(Exchange venue) const {
+    for (const auto& book : books_) {
+        if (book->config.venue == venue) {
+            return "http://" + config_.bind_addr + ":" + std::to_string(port_) + pathFor(venue);
+        }
+    }
+    return std::string();
+}
+
+bool MockExchangeServer::writeConfig(const std::string& path) const {
+    json exchanges = json::array();
+    for (const auto& book : books_) {
+        Exchange venue = book->config.venue;
+        exchanges.push_back({
+            {"id", configId(venue)},
+            {"name", exchangeName(venue)},
+            {"enabled", true},
+            {"order_book_config", {{"full_url", urlFor(venue)}}},
+            // A local server has no rate limit worth respecting
+            {"rate_limits", {{"requests_per_second", 1000}, {"burst_limit", 10}}}
+        });
+    }
+    json config = {
+        {"version", "2.0"},
+        {"exchanges", exchanges},
+        {"scheduler", {{"utilisation", 1.0}, {"max_in_flight", 0}}}
+    };
+    
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << config.dump(2) << "\n";
+    return static_cast<bool>(file);
+}
+
+void MockExchangeServer::acceptLoop() {
+    while (running_.load()) {
+        int fd = ::accept(listen_fd_, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            break;  // Listening socket shut down
+        }
+        int nodelay = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+    
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        if (!running_.load()) {
+            ::close(fd);
+            break;
+        }
+        // Reap connections the client already closed
+        for (auto it = connections_.begin(); it != connections_.end();) {
+            if ((*it)->done.load()) {
+                (*it)->thread.join();
+                ::close((*it)->fd);
+                it = connections_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        Connection& ref = *connection;
+        connection->thread = std::thread([this, &ref] { serve(ref); });
+        connections_.push_back(std::move(connection));
+    }
+}
+
+void MockExchangeServer::serve(Connection& connection) {
+    std::string buffer;
+    char chunk[16 * 1024];
+    while (running_.load()) {
+        size_t end = buffer.find("\r\n\r\n");
+        if (end == std::string::npos) {
+            ssize_t n = ::recv(connection.fd, chunk, sizeof(chunk), 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            buffer.append(chunk, static_cast<size_t>(n));
+            continue;
+        }
+        // GET requests only, so the headers are the whole request
+        std::string request = buffer.substr(0, end + 4);
+        buffer.erase(0, end + 4);
+        if (!sendAll(connection.fd, respond(request))) break;
+    }
+    connection.done = true;
+}
+
+std::string MockExchangeServer::respond(const std::string& request) {
+    requests_.fetch_add(1, std::memory_order_relaxed);
+    
+    size_t path_begin = request.find(' ');
+    size_t path_end = path_begin == std::string::npos ? path_begin : request.find(' ', path_begin + 1);
+    if (path_end == std::string::npos || request.compare(0, path_begin, "GET") != 0) {
+        return response("405 Method Not Allowed", "text/plain", "", "GET only\n");
+    }
+    std::string path = request.substr(path_begin + 1, path_end - path_begin - 1);
+    path = path.substr(0, path.find('?'));
+    
+    VenueBook* book = nullptr;
+    for (const auto& candidate : books_) {
+        std::string venue_path = pathFor(candidate->config.venue);
+        if (venue_path.substr(0, venue_path.find('?')) == path) {
+            book = candidate.get();
+            break;
+        }
+    }
+    if (!book) {
+        return response("404 Not Found", "text/plain", "", "Unknown endpoint\n");
+    }
+    
+    double delay_ms;
+    bool inject_error;
+    {
+        std::lock_guard<std::mutex> lock(book->mutex);
+        delay_ms = book->config.latency.sampleMs(book->rng);
+        inject_error = book->config.error_rate > 0.0 &&
+            std::uniform_real_distribution<double>(0.0, 1.0)(book->rng) < book->config.error_rate;
+    }
+    if (delay_ms > 0.0) {
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(delay_ms));
+    }
+    
+    if (inject_error) {
+        errors_.fetch_add(1, std::memory_order_relaxed);
+        return response("503 Service Unavailable", "text/html", "",
+                        "<html><body><h1>503 Service Unavailable</h1></body></html>");
+    }
+    
+    std::lock_guard<std::mutex> lock(book->mutex);
+    book->churn();
+    if (!book->config.validators) {
+        return response("200 OK", "application/json", "", book->render());
+    }
+    std::string etag = "\"v" + std::to_string(book->version) + "\"";
+    if (headerValue(request, "If-None-Match") == etag) {
+        not_modified_.fetch_add(1, std::memory_order_relaxed);
+        return response("304 Not Modified", "application/json", etag, "");
+    }
+    return response("200 OK", "application/json", etag, book->render());
+}
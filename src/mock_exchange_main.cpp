@@ -0,0 +1,123 @@
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include "mock_exchange.hpp"
+
+// Local stand-in for the venue REST APIs, so the aggregator can be driven
+// without network access:
+//
+//   ./mock_exchange --port 8080 --depth 5000 --latency-ms 20 --p99-ms 120
+//       --error-rate 0.01 --churn 0.05 --write-config /tmp/mock.json
+//   ./orderbook_aggregator --config /tmp/mock.json --cycles 100
+
+namespace {
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void onSignal(int) {
+    g_stop = 1;
+}
+
+std::string parseStringOption(int argc, char* argv[], const char* name) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0 && i + 1 < argc) {
+            return argv[i + 1];
+        }
+    }
+    return "";
+}
+
+double parseDoubleOption(int argc, char* argv[], const char* name, double fallback) {
+    std::string value = parseStringOption(argc, argv, name);
+    return value.empty() ? fallback : std::stod(value);
+}
+
+bool hasFlag(int argc, char* argv[], const char* name) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0) return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        std::string venue_list = parseStringOption(argc, argv, "--venues");
+        if (venue_list.empty()) {
+            venue_list = "coinbase,gemini,binance,kraken";
+        }
+    
+        // --fixture VENUE=PATH, repeatable: serve a captured response verbatim
+        std::map<std::string, std::string> fixtures;
+        for (int i = 1; i + 1 < argc; ++i) {
+            if (std::strcmp(argv[i], "--fixture") == 0) {
+                std::string spec = argv[i + 1];
+                size_t eq = spec.find('=');
+                if (eq == std::string::npos) {
+                    std::cerr << "Error: Expected --fixture VENUE=PATH, got: " << spec << "\n";
+                    return 1;
+                }
+                fixtures[spec.substr(0, eq)] = spec.substr(eq + 1);
+            }
+        }
+    
+        MockServerConfig config;
+        std::string bind = parseStringOption(argc, argv, "--bind");
+        if (!bind.empty()) config.bind_addr = bind;
+        config.port = static_cast<uint16_t>(parseDoubleOption(argc, argv, "--port", 8080));
+        config.seed = static_cast<uint64_t>(parseDoubleOption(argc, argv, "--seed", 1));
+    
+        std::stringstream ids(venue_list);
+        std::string id;
+        while (std::getline(ids, id, ',')) {
+            MockVenueConfig venue;
+            if (!exchangeFromId(id, venue.venue)) {
+                std::cerr << "Error: Unknown venue '" << id << "' (coinbase, gemini, binance, kraken)\n";
+                return 1;
+            }
+            venue.depth = static_cast<size_t>(parseDoubleOption(argc, argv, "--depth", 1000));
+            venue.latency.median_ms = parseDoubleOption(argc, argv, "--latency-ms", 0.0);
+            venue.latency.p99_ms = parseDoubleOption(argc, argv, "--p99-ms", 0.0);
+            venue.error_rate = parseDoubleOption(argc, argv, "--error-rate", 0.0);
+            venue.churn = parseDoubleOption(argc, argv, "--churn", 0.01);
+            venue.validators = !hasFlag(argc, argv, "--no-validators");
+            auto fixture = fixtures.find(id);
+            if (fixture != fixtures.end()) venue.fixture_path = fixture->second;
+            config.venues.push_back(venue);
+        }
+    
+        MockExchangeServer server(config);
+        for (const auto& venue : config.venues) {
+            std::cout << exchangeName(venue.venue) << ": " << server.urlFor(venue.venue) << "\n";
+        }
+    
+        std::string config_path = parseStringOption(argc, argv, "--write-config");
+        if (!config_path.empty()) {
+            if (!server.writeConfig(config_path)) {
+                std::cerr << "Error: Could not write " << config_path << "\n";
+                return 1;
+            }
+            std::cout << "Wrote " << config_path << "\n";
+        }
+        std::cout << std::flush;
+    
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+        while (!g_stop) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        server.stop();
+    
+        std::cerr << server.requests() << " requests, "
+                  << server.notModified() << " not modified (304), "
+                  << server.injectedErrors() << " injected errors\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
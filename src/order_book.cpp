@@ -1,54 +1,278 @@
 #include "order_book.hpp"
 #include <algorithm>
+#include <mutex>
+
+namespace {
+
+// Moves [first, last) of all three columns to start at `to`
+void shiftColumns(Price* prices, Quantity* sizes, Exchange* venues, size_t first, size_t last, size_t to) {
+    if (to < first) {
+        std::copy(prices + first, prices + last, prices + to);
+        std::copy(sizes + first, sizes + last, sizes + to);
+        std::copy(venues + first, venues + last, venues + to);
+    } else {
+        std::copy_backward(prices + first, prices + last, prices + to + (last - first));
+        std::copy_backward(sizes + first, sizes + last, sizes + to + (last - first));
+        std::copy_backward(venues + first, venues + last, venues + to + (last - first));
+    }
+}
+
+}  // namespace
+
+template<typename Compare>
+BookSide<Compare>::BookSide(HugePageArena::Backing pages)
+    : arenas_{HugePageArena(pages), HugePageArena(pages)} {}
+
+template<typename Compare>
+size_t BookSide<Compare>::lowerBound(Price price) const noexcept {
+    const Price* first = cols_.prices + head_;
+    return static_cast<size_t>(std::lower_bound(first, first + count_, price, Compare()) - first);
+}
+
+template<typename Compare>
+size_t BookSide<Compare>::upperBound(Price price) const noexcept {
+    const Price* first = cols_.prices + head_;
+    return static_cast<size_t>(std::upper_bound(first, first + count_, price, Compare()) - first);
+}
+
+template<typename Compare>
+typename BookSide<Compare>::Columns BookSide<Compare>::carveSpare(size_t count, size_t& head) {
+    const size_t capacity = std::max<size_t>(count + count / 2, 256);
+    HugePageArena& spare = arenas_[live_ ^ 1];
+    spare.reset();
+    Columns columns;
+    columns.prices = spare.allocateArray<Price>(capacity);
+    columns.sizes = spare.allocateArray<Quantity>(capacity);
+    columns.venues = spare.allocateArray<Exchange>(capacity);
+    columns.capacity = capacity;
+    // Half the slack in front, rounded so every column's first level
+    // still starts a cache line
+    head = ((capacity - count) / 2) & ~size_t{kCacheLineSize - 1};
+    return columns;
+}
+
+template<typename Compare>
+void BookSide<Compare>::swapIn(const Columns& columns, size_t head, size_t count) noexcept {
+    cols_ = columns;
+    head_ = head;
+    count_ = count;
+    live_ ^= 1;
+}
+
+template<typename Compare>
+void BookSide<Compare>::insertAt(size_t pos, Price price, Quantity size, Exchange exchange) {
+    size_t at;
+    if (count_ == cols_.capacity) {
+        size_t head;
+        Columns next = carveSpare(count_ + 1, head);
+        const size_t from = head_;
+        std::copy(cols_.prices + from, cols_.prices + from + pos, next.prices + head);
+        std::copy(cols_.sizes + from, cols_.sizes + from + pos, next.sizes + head);
+        std::copy(cols_.venues + from, cols_.venues + from + pos, next.venues + head);
+        std::copy(cols_.prices + from + pos, cols_.prices + from + count_, next.prices + head + pos + 1);
+        std::copy(cols_.sizes + from + pos, cols_.sizes + from + count_, next.sizes + head + pos + 1);
+        std::copy(cols_.venues + from + pos, cols_.venues + from + count_, next.venues + head + pos + 1);
+        swapIn(next, head, count_);
+        at = head_ + pos;
+    } else if (head_ > 0 && (pos < count_ - pos || head_ + count_ == cols_.capacity)) {
+        shiftColumns(cols_.prices, cols_.sizes, cols_.venues, head_, head_ + pos, head_ - 1);
+        --head_;
+        at = head_ + pos;
+    } else {
+        shiftColumns(cols_.prices, cols_.sizes, cols_.venues, head_ + pos, head_ + count_, head_ + pos + 1);
+        at = head_ + pos;
+    }
+    cols_.prices[at] = price;
+    cols_.sizes[at] = size;
+    cols_.venues[at] = exchange;
+    ++count_;
+    notify(price, size);
+}
+
+template<typename Compare>
+void BookSide<Compare>::eraseAt(size_t pos) {
+    notify(cols_.prices[head_ + pos], -cols_.sizes[head_ + pos]);
+    if (pos < count_ - 1 - pos) {
+        shiftColumns(cols_.prices, cols_.sizes, cols_.venues, head_, head_ + pos, head_ + 1);
+        ++head_;
+    } else {
+        shiftColumns(cols_.prices, cols_.sizes, cols_.venues, head_ + pos + 1, head_ + count_, head_ + pos);
+    }
+    --count_;
+}
+
+template<typename Compare>
+void BookSide<Compare>::insert(Price price, Quantity size, Exchange exchange) {
+    insertAt(upperBound(price), price, size, exchange);
+}
+
+template<typename Compare>
+void BookSide<Compare>::set(Price price, Quantity size, Exchange exchange) {
+    size_t first = lowerBound(price);
+    size_t last = upperBound(price);
+    for (size_t i = first; i < last; ++i) {
+        if (cols_.venues[head_ + i] == exchange) {
+            if (size == 0) {
+                eraseAt(i);
+            } else {
+                notify(price, size - cols_.sizes[head_ + i]);
+                cols_.sizes[head_ + i] = size;
+            }
+            return;
+        }
+    }
+    if (size != 0) {
+        insertAt(last, price, size, exchange);
+    }
+}
+
+template<typename Compare>
+void BookSide<Compare>::merge(const std::vector<PriceLevel>& levels, const Exchange* replacing) {
+    if (levels.empty() && !replacing) {
+        return;
+    }
+    incoming_.assign(levels.begin(), levels.end());
+    std::stable_sort(incoming_.begin(), incoming_.end(), [](const PriceLevel& a, const PriceLevel& b) {
+        return Compare()(a.price, b.price);
+    });
+
+    size_t head;
+    Columns next = carveSpare(count_ + incoming_.size(), head);
+    size_t out = head;
+    size_t j = 0;
+    outgoing_.clear();
+    auto emit = [&](Price price, Quantity size, Exchange exchange) {
+        next.prices[out] = price;
+        next.sizes[out] = size;
+        next.venues[out] = exchange;
+        ++out;
+    };
+    for (size_t i = head_; i < head_ + count_; ++i) {
+        if (replacing && cols_.venues[i] == *replacing) {
+            if (listener_) outgoing_.emplace_back(cols_.prices[i], cols_.sizes[i], cols_.venues[i]);
+            continue;
+        }
+        // New levels go after existing ones at the same price
+        for (; j < incoming_.size() && Compare()(incoming_[j].price, cols_.prices[i]); ++j) {
+            emit(incoming_[j].price, incoming_[j].size, incoming_[j].exchange);
+        }
+        emit(cols_.prices[i], cols_.sizes[i], cols_.venues[i]);
+    }
+    for (; j < incoming_.size(); ++j) {
+        emit(incoming_[j].price, incoming_[j].size, incoming_[j].exchange);
+    }
+    swapIn(next, head, out - head);
+    
+    if (!listener_) {
+        return;
+    }
+    if (replacing) {
+        notifyReplaced();
+    } else {
+        for (const auto& level : incoming_) notify(level.price, level.size);
+    }
+}
+
+template<typename Compare>
+void BookSide<Compare>::notifyReplaced() {
+    // Both runs are in book order: step through prices best-first and
+    // report only where the venue's total at a price moved
+    size_t i = 0;
+    size_t j = 0;
+    while (i < outgoing_.size() || j < incoming_.size()) {
+        Price price = j == incoming_.size() ||
+                      (i < outgoing_.size() && !Compare()(incoming_[j].price, outgoing_[i].price))
+            ? outgoing_[i].price : incoming_[j].price;
+        Quantity delta = 0;
+        for (; i < outgoing_.size() && outgoing_[i].price == price; ++i) delta -= outgoing_[i].size;
+        for (; j < incoming_.size() && incoming_[j].price == price; ++j) delta += incoming_[j].size;
+        notify(price, delta);
+    }
+}
+
+template<typename Compare>
+void BookSide<Compare>::copyTo(std::vector<PriceLevel>& out) const {
+    out.reserve(out.size() + count_);
+    for (size_t i = head_; i < head_ + count_; ++i) {
+        out.emplace_back(cols_.prices[i], cols_.sizes[i], cols_.venues[i]);
+    }
+}
+
+template class BookSide<std::greater<Price>>;
+template class BookSide<std::less<Price>>;
 
 void OrderBook::clear() {
     std::unique_lock lock(mutex_);
+    version_.fetch_add(1, std::memory_order_release);
     bids_.clear();
     asks_.clear();
+    if (listener_) listener_->onReset(bids_.view(), asks_.view());
 }
 
 void OrderBook::addBid(Price price, Quantity size, Exchange exchange) {
     std::unique_lock lock(mutex_);
-    bids_.emplace(price, PriceLevel(price, size, exchange));
+    version_.fetch_add(1, std::memory_order_release);
+    bids_.insert(price, size, exchange);
+    commit();
 }
 
 void OrderBook::addAsk(Price price, Quantity size, Exchange exchange) {
     std::unique_lock lock(mutex_);
-    asks_.emplace(price, PriceLevel(price, size, exchange));
+    version_.fetch_add(1, std::memory_order_release);
+    asks_.insert(price, size, exchange);
+    commit();
 }
 
 std::vector<PriceLevel> OrderBook::getBids() const {
     std::shared_lock lock(mutex_);  // Multiple readers allowed
     std::vector<PriceLevel> result;
-    result.reserve(bids_.size());
-    for (const auto& [price, level] : bids_) {
-        result.push_back(level);
-    }
+    bids_.copyTo(result);
     return result;
 }
 
 std::vector<PriceLevel> OrderBook::getAsks() const {
     std::shared_lock lock(mutex_);
     std::vector<PriceLevel> result;
-    result.reserve(asks_.size());
-    for (const auto& [price, level] : asks_) {
-        result.push_back(level);
-    }
+    asks_.copyTo(result);
     return result;
 }
 
 void OrderBook::mergeBids(const std::vector<PriceLevel>& bids) {
     std::unique_lock lock(mutex_);
-    for (const auto& bid : bids) {
-        bids_.emplace(bid.price, bid);
-    }
+    version_.fetch_add(1, std::memory_order_release);
+    bids_.merge(bids);
+    commit();
 }
 
 void OrderBook::mergeAsks(const std::vector<PriceLevel>& asks) {
     std::unique_lock lock(mutex_);
-    for (const auto& ask : asks) {
-        asks_.emplace(ask.price, ask);
-    }
+    version_.fetch_add(1, std::memory_order_release);
+    asks_.merge(asks);
+    commit();
+}
+
+void OrderBook::setBidLevel(Price price, Quantity size, Exchange exchange) {
+    std::unique_lock lock(mutex_);
+    version_.fetch_add(1, std::memory_order_release);
+    bids_.set(price, size, exchange);
+    commit();
+}
+
+void OrderBook::setAskLevel(Price price, Quantity size, Exchange exchange) {
+    std::unique_lock lock(mutex_);
+    version_.fetch_add(1, std::memory_order_release);
+    asks_.set(price, size, exchange);
+    commit();
+}
+
+void OrderBook::replaceExchange(Exchange exchange,
+                                const std::vector<PriceLevel>& bids,
+                                const std::vector<PriceLevel>& asks) {
+    std::unique_lock lock(mutex_);
+    version_.fetch_add(1, std::memory_order_release);
+    bids_.merge(bids, &exchange);
+    asks_.merge(asks, &exchange);
+    commit();
 }
 
 size_t OrderBook::bidDepth() const {
@@ -60,3 +284,16 @@ size_t OrderBook::askDepth() const {
     std::shared_lock lock(mutex_);
     return asks_.size();
 }
+
+HugePageArena::Backing OrderBook::backing() const {
+    std::shared_lock lock(mutex_);
+    return asks_.backing();
+}
+
+void OrderBook::setListener(BookListener* listener) {
+    std::unique_lock lock(mutex_);
+    listener_ = listener;
+    bids_.listen(listener, BookListener::Side::BID);
+    asks_.listen(listener, BookListener::Side::ASK);
+    if (listener_) listener_->onReset(bids_.view(), asks_.view());
+}
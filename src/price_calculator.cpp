@@ -1,7 +1,14 @@
 #include "price_calculator.hpp"
+#include "execution_walker.hpp"
+#include "json.hpp"
 #include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <numeric>
+
+using json = nlohmann::json;
 
 // Compile with -DDEBUG_ORDERBOOK to enable
 #ifdef DEBUG_ORDERBOOK
@@ -10,60 +17,124 @@
 #define DEBUG_LOG(x)
 #endif
 
-ExecutionResult PriceCalculator::calculateBuyPrice(
-    const std::vector<PriceLevel>& asks, 
-    Quantity quantity) {
-    
-    ExecutionResult result{0, 0, false, ""};
-    
-    if (asks.empty()) {
-        result.error = "No asks available";
-        return result;
-    }
-    
-    // Sort ascending (though multimap already sorted, this handles edge cases)
-    std::vector<PriceLevel> sorted_asks = asks;
-    std::sort(sorted_asks.begin(), sorted_asks.end(), 
+namespace {
+
+#ifdef DEBUG_ORDERBOOK
+template<typename Side>
+void logExecution(const char* label, const std::vector<PriceLevel>& levels,
+                  Quantity quantity, const ExecutionResult& result) {
+    std::vector<PriceLevel> sorted = levels;
+    std::sort(sorted.begin(), sorted.end(),
         [](const PriceLevel& a, const PriceLevel& b) {
-            return a.price < b.price;
+            return Side::better(a.price, b.price);
         });
-    
-    Quantity remaining = quantity;
-    
-    DEBUG_LOG("\n=== BUY EXECUTION ===");
+
+    DEBUG_LOG("\n=== " << label << " EXECUTION ===");
     DEBUG_LOG("Target: " << (quantity / static_cast<double>(QUANTITY_SCALE)) << " BTC");
-    DEBUG_LOG("Total ask levels: " << sorted_asks.size());
-    
+    DEBUG_LOG("Total levels: " << sorted.size());
+
+    Quantity remaining = quantity;
     int level = 0;
-    for (const auto& ask : sorted_asks) {
+    for (const auto& lvl : sorted) {
         if (remaining <= 0) break;
-        
-        Quantity fill_amount = std::min(remaining, ask.size);
-        
-        // Fixed-point multiplication: (cents * satoshis) / satoshis = cents
-        // Example: (10336750 * 100000000) / 100000000 = 10336750 cents = $103367.50
-        int64_t fill_cost_cents = (static_cast<int64_t>(ask.price) * 
-                                   static_cast<int64_t>(fill_amount)) / QUANTITY_SCALE;
-        
-        result.total_cost += fill_cost_cents;
-        result.quantity_filled += fill_amount;
+        Quantity fill_amount = std::min(remaining, lvl.size);
         remaining -= fill_amount;
-        
-        DEBUG_LOG("Level " << ++level << ": " 
+        DEBUG_LOG("Level " << ++level << ": "
                  << (fill_amount / static_cast<double>(QUANTITY_SCALE)) << " BTC @ $"
-                 << (ask.price / static_cast<double>(PRICE_SCALE)) 
-                 << " = $" << (fill_cost_cents / static_cast<double>(PRICE_SCALE))
-                 << " (" << exchangeName(ask.exchange) << ")");
+                 << (lvl.price / static_cast<double>(PRICE_SCALE))
+                 << " (" << exchangeName(lvl.exchange) << ")");
+    }
+
+    DEBUG_LOG("Total: $" << result.getTotalCostUSD());
+    DEBUG_LOG("Remaining: " << (remaining / static_cast<double>(QUANTITY_SCALE)) << " BTC\n");
+}
+#endif
+
+// Levels best-first for Side; copies and sorts only when they are not
+template<typename Side, typename Func>
+auto withSortedLevels(const std::vector<PriceLevel>& levels, Func&& func) {
+    auto order = [](const PriceLevel& a, const PriceLevel& b) {
+        return Side::better(a.price, b.price);
+    };
+    if (std::is_sorted(levels.begin(), levels.end(), order)) {
+        return func(levels.data(), levels.size());
+    }
+    std::vector<PriceLevel> sorted = levels;
+    std::sort(sorted.begin(), sorted.end(), order);
+    return func(sorted.data(), sorted.size());
+}
+
+// Routes one size, dropping venues whose share falls under their minimum
+// and re-walking until every share is acceptable (at most once per venue)
+template<typename Side>
+RoutedExecution routeOne(const PriceLevel* levels, size_t n, Quantity quantity,
+                         const RoutingRules& rules, VenueMask allowed) {
+    using Router = execution::VenueRouter<Side>;
+    RoutedExecution result;
+    for (size_t attempt = 0; attempt <= kRoutedVenues; ++attempt) {
+        Router::routeSorted(levels, n, &quantity, 1, rules, allowed,
+                            [&result](size_t) -> RoutedExecution& { return result; });
+        VenueMask undersized = Router::undersized(result, rules);
+        if (undersized == 0) {
+            break;
+        }
+        allowed &= ~undersized;
+    }
+    return result;
+}
+
+template<typename Side>
+RoutedExecution route(const std::vector<PriceLevel>& levels, Quantity quantity, const RoutingRules& rules) {
+    return withSortedLevels<Side>(levels, [&](const PriceLevel* sorted, size_t n) {
+        return routeOne<Side>(sorted, n, quantity, rules, rules.allowed);
+    });
+}
+
+template<typename Side>
+void routeBatch(const std::vector<PriceLevel>& levels, const std::vector<Quantity>& quantities,
+                const RoutingRules& rules, std::vector<RoutedExecution>& out) {
+    out.resize(quantities.size());
+    
+    // The walk needs ascending sizes; only build a permutation if they are not
+    std::vector<size_t> order;
+    std::vector<Quantity> ascending;
+    const Quantity* targets = quantities.data();
+    if (!std::is_sorted(quantities.begin(), quantities.end())) {
+        order.resize(quantities.size());
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::sort(order.begin(), order.end(),
+                  [&](size_t a, size_t b) { return quantities[a] < quantities[b]; });
+        ascending.reserve(order.size());
+        for (size_t i : order) ascending.push_back(quantities[i]);
+        targets = ascending.data();
     }
     
-    result.fully_filled = (remaining == 0);
+    withSortedLevels<Side>(levels, [&](const PriceLevel* sorted, size_t n) {
+        using Router = execution::VenueRouter<Side>;
+        Router::routeSorted(sorted, n, targets, quantities.size(), rules, rules.allowed,
+            [&](size_t k) -> RoutedExecution& { return out[order.empty() ? k : order[k]]; });
+        
+        // Sizes that hit a minimum-size constraint need their own re-walk
+        for (size_t i = 0; i < out.size(); ++i) {
+            if (Router::undersized(out[i], rules) != 0) {
+                out[i] = routeOne<Side>(sorted, n, quantities[i], rules, rules.allowed);
+            }
+        }
+        return 0;
+    });
+}
+
+}  // namespace
+
+ExecutionResult PriceCalculator::calculateBuyPrice(
+    const std::vector<PriceLevel>& asks, 
+    Quantity quantity) {
     
-    DEBUG_LOG("Total cost: $" << result.getTotalCostUSD());
-    DEBUG_LOG("Remaining: " << (remaining / static_cast<double>(QUANTITY_SCALE)) << " BTC\n");
+    auto result = execution::ExecutionWalker<execution::AskSide>::walk(asks, quantity);
     
-    if (!result.fully_filled) {
-        result.error = "Insufficient liquidity";
-    }
+#ifdef DEBUG_ORDERBOOK
+    logExecution<execution::AskSide>("BUY", asks, quantity, result);
+#endif
     
     return result;
 }
@@ -72,55 +143,68 @@ ExecutionResult PriceCalculator::calculateSellPrice(
     const std::vector<PriceLevel>& bids, 
     Quantity quantity) {
     
-    ExecutionResult result{0, 0, false, ""};
-    
-    if (bids.empty()) {
-        result.error = "No bids available";
-        return result;
-    }
-    
-    // Sort descending (though multimap already sorted)
-    std::vector<PriceLevel> sorted_bids = bids;
-    std::sort(sorted_bids.begin(), sorted_bids.end(), 
-        [](const PriceLevel& a, const PriceLevel& b) {
-            return a.price > b.price;
-        });
-    
-    Quantity remaining = quantity;
+    auto result = execution::ExecutionWalker<execution::BidSide>::walk(bids, quantity);
     
-    DEBUG_LOG("\n=== SELL EXECUTION ===");
-    DEBUG_LOG("Target: " << (quantity / static_cast<double>(QUANTITY_SCALE)) << " BTC");
-    DEBUG_LOG("Total bid levels: " << sorted_bids.size());
+#ifdef DEBUG_ORDERBOOK
+    logExecution<execution::BidSide>("SELL", bids, quantity, result);
+#endif
     
-    int level = 0;
-    for (const auto& bid : sorted_bids) {
-        if (remaining <= 0) break;
-        
-        Quantity fill_amount = std::min(remaining, bid.size);
-        
-        // Fixed-point multiplication
-        int64_t fill_revenue_cents = (static_cast<int64_t>(bid.price) * 
-                                      static_cast<int64_t>(fill_amount)) / QUANTITY_SCALE;
-        
-        result.total_cost += fill_revenue_cents;
-        result.quantity_filled += fill_amount;
-        remaining -= fill_amount;
-        
-        DEBUG_LOG("Level " << ++level << ": " 
-                 << (fill_amount / static_cast<double>(QUANTITY_SCALE)) << " BTC @ $"
-                 << (bid.price / static_cast<double>(PRICE_SCALE)) 
-                 << " = $" << (fill_revenue_cents / static_cast<double>(PRICE_SCALE))
-                 << " (" << exchangeName(bid.exchange) << ")");
+    return result;
+}
+
+RoutedExecution PriceCalculator::routeBuy(const std::vector<PriceLevel>& asks, Quantity quantity,
+                                          const RoutingRules& rules) {
+    return route<execution::AskSide>(asks, quantity, rules);
+}
+
+RoutedExecution PriceCalculator::routeSell(const std::vector<PriceLevel>& bids, Quantity quantity,
+                                           const RoutingRules& rules) {
+    return route<execution::BidSide>(bids, quantity, rules);
+}
+
+void PriceCalculator::routeBuyBatch(const std::vector<PriceLevel>& asks,
+                                    const std::vector<Quantity>& quantities,
+                                    const RoutingRules& rules, std::vector<RoutedExecution>& out) {
+    routeBatch<execution::AskSide>(asks, quantities, rules, out);
+}
+
+void PriceCalculator::routeSellBatch(const std::vector<PriceLevel>& bids,
+                                     const std::vector<Quantity>& quantities,
+                                     const RoutingRules& rules, std::vector<RoutedExecution>& out) {
+    routeBatch<execution::BidSide>(bids, quantities, rules, out);
+}
+
+RoutingRules RoutingRules::load(const std::string& config_path) {
+    RoutingRules rules;
+    if (config_path.empty()) {
+        return rules;
     }
     
-    result.fully_filled = (remaining == 0);
-    
-    DEBUG_LOG("Total revenue: $" << result.getTotalCostUSD());
-    DEBUG_LOG("Remaining: " << (remaining / static_cast<double>(QUANTITY_SCALE)) << " BTC\n");
-    
-    if (!result.fully_filled) {
-        result.error = "Insufficient liquidity";
+    try {
+        std::ifstream file(config_path);
+        if (!file.is_open()) {
+            return rules;
+        }
+        
+        json root;
+        file >> root;
+        for (const auto& exchange : root.value("exchanges", json::array())) {
+            Exchange id;
+            if (!exchangeFromId(exchange.value("id", ""), id) || !exchange.contains("routing")) {
+                continue;
+            }
+            const auto& routing = exchange["routing"];
+            VenueRule& rule = rules[id];
+            rule.taker_fee_ppm = std::llround(routing.value("taker_fee_bps", 0.0) * (FEE_SCALE / 10000));
+            rule.min_size = std::llround(routing.value("min_order_size", 0.0) * QUANTITY_SCALE);
+            if (rule.taker_fee_ppm < 0 || rule.taker_fee_ppm >= FEE_SCALE || rule.min_size < 0) {
+                throw std::runtime_error(std::string("out-of-range routing rule for ") + exchangeName(id));
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Warning: Invalid routing config: " << e.what() << "\n";
+        rules = RoutingRules{};
     }
     
-    return result;
+    return rules;
 }
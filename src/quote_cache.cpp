@@ -0,0 +1,59 @@
+#include "quote_cache.hpp"
+#include "execution_walker.hpp"
+#include <algorithm>
+
+ExecutionResult QuoteCache::quote(QuoteSide side, Quantity quantity, VenueMask venues) {
+    const Key key{side, quantity, venues};
+    const uint64_t version = book_.version();
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (version != cached_version_) {
+            entries_.clear();
+            cached_version_ = version;
+        } else if (auto it = entries_.find(key); it != entries_.end()) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return it->second;
+        }
+    }
+    
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    ExecutionResult result = compute(book_, side, quantity, venues);
+    
+    // Only publish if the book did not move while we were walking it
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (book_.version() == version && cached_version_ == version &&
+        entries_.size() < max_entries_) {
+        entries_.emplace(key, result);
+    }
+    return result;
+}
+
+size_t QuoteCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+ExecutionResult QuoteCache::compute(const OrderBook& book, QuoteSide side,
+                                    Quantity quantity, VenueMask venues) {
+    // Whole book: walk the columns in place, no copy
+    if (venues == ALL_VENUES) {
+        auto walk = [quantity, side](const BookSideView& view) {
+            return side == QuoteSide::BUY
+                ? execution::ExecutionWalker<execution::AskSide>::walkColumns(view.prices, view.sizes, view.count, quantity)
+                : execution::ExecutionWalker<execution::BidSide>::walkColumns(view.prices, view.sizes, view.count, quantity);
+        };
+        return side == QuoteSide::BUY ? book.readAsks(walk) : book.readBids(walk);
+    }
+    
+    // Venue subset: copy the side out and drop the other venues' levels
+    std::vector<PriceLevel> levels = side == QuoteSide::BUY ? book.getAsks() : book.getBids();
+    levels.erase(std::remove_if(levels.begin(), levels.end(),
+        [venues](const PriceLevel& level) {
+            return (venueBit(level.exchange) & venues) == 0;
+        }), levels.end());
+    
+    return side == QuoteSide::BUY
+        ? PriceCalculator::calculateBuyPrice(levels, quantity)
+        : PriceCalculator::calculateSellPrice(levels, quantity);
+}
@@ -1,3 +0,0 @@
-#include "rate_limiter.hpp"
-
-// Implementation is header-only for template optimization
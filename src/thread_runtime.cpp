@@ -0,0 +1,226 @@
+#include "thread_runtime.hpp"
+#include "work_stealing_pool.hpp"
+#include "json.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CPU_RELAX() _mm_pause()
+#else
+#define CPU_RELAX() std::this_thread::yield()
+#endif
+
+using json = nlohmann::json;
+
+namespace {
+
+std::vector<int> readCpuList(const json& section, const char* key) {
+    std::vector<int> cpus;
+    if (section.contains(key)) {
+        for (const auto& cpu : section[key]) {
+            cpus.push_back(cpu.get<int>());
+        }
+    }
+    return cpus;
+}
+
+struct RegisteredThread {
+    std::string name;
+    pid_t tid;
+};
+
+std::mutex& registryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<RegisteredThread>& registry() {
+    static std::vector<RegisteredThread> threads;
+    return threads;
+}
+
+}  // namespace
+
+RuntimeConfig RuntimeConfig::load(const std::string& config_path) {
+    RuntimeConfig config;
+    if (config_path.empty()) {
+        return config;
+    }
+    
+    try {
+        std::ifstream file(config_path);
+        if (!file.is_open()) {
+            return config;
+        }
+        
+        json root;
+        file >> root;
+        if (!root.contains("runtime")) {
+            return config;
+        }
+        
+        const auto& runtime = root["runtime"];
+        config.enabled = runtime.value("enabled", false);
+        config.busy_poll = runtime.value("busy_poll", false);
+        config.parse_threads = runtime.value("parse_threads", 0u);
+        config.network_cpus = readCpuList(runtime, "network_cpus");
+        config.parse_cpus = readCpuList(runtime, "parse_cpus");
+        config.book_cpus = readCpuList(runtime, "book_cpus");
+        config.query_cpus = readCpuList(runtime, "query_cpus");
+    } catch (const std::exception& e) {
+        std::cerr << "Warning: Invalid runtime config: " << e.what() << "\n";
+        config = RuntimeConfig{};
+    }
+    
+    return config;
+}
+
+namespace thread_util {
+
+bool pinCurrentThread(const std::vector<int>& cpus) {
+    if (cpus.empty()) {
+        return true;
+    }
+    
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+void nameCurrentThread(const std::string& name) {
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+}
+
+void registerCurrentThread(const std::string& name) {
+    pid_t tid = static_cast<pid_t>(::syscall(SYS_gettid));
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registry().push_back({name, tid});
+}
+
+std::vector<std::pair<std::string, ContextSwitches>> registeredThreadSwitches() {
+    std::vector<RegisteredThread> threads;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        threads = registry();
+    }
+    
+    std::vector<std::pair<std::string, ContextSwitches>> result;
+    for (const auto& thread : threads) {
+        ContextSwitches switches;
+        std::ifstream status("/proc/self/task/" + std::to_string(thread.tid) + "/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            std::istringstream fields(line);
+            std::string key;
+            uint64_t value = 0;
+            fields >> key >> value;
+            if (key == "voluntary_ctxt_switches:") {
+                switches.voluntary = value;
+            } else if (key == "nonvoluntary_ctxt_switches:") {
+                switches.involuntary = value;
+            }
+        }
+        result.emplace_back(thread.name, switches);
+    }
+    return result;
+}
+
+}  // namespace thread_util
+
+PinnedWorker::PinnedWorker(std::string name, std::vector<int> cpus, bool busy_poll)
+    : name_(std::move(name))
+    , cpus_(std::move(cpus))
+    , busy_poll_(busy_poll)
+    , thread_([this]() { run(); }) {}
+
+PinnedWorker::~PinnedWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_.store(true, std::memory_order_release);
+    }
+    ready_.notify_one();
+    thread_.join();
+}
+
+void PinnedWorker::push(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+        queued_.fetch_add(1, std::memory_order_release);
+    }
+    if (!busy_poll_) {
+        ready_.notify_one();
+    }
+}
+
+void PinnedWorker::run() {
+    thread_util::nameCurrentThread(name_);
+    if (!thread_util::pinCurrentThread(cpus_)) {
+        std::cerr << "Warning: Could not pin " << name_ << " to its configured CPUs\n";
+    }
+    thread_util::registerCurrentThread(name_);
+    
+    while (true) {
+        if (busy_poll_) {
+            // Never sleep: the dedicated core spins until work shows up
+            while (queued_.load(std::memory_order_acquire) == 0 &&
+                   !stop_.load(std::memory_order_acquire)) {
+                CPU_RELAX();
+            }
+        }
+        
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this]() {
+                return !tasks_.empty() || stop_.load(std::memory_order_acquire);
+            });
+            if (tasks_.empty()) {
+                return;  // Stopping and drained
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+            queued_.fetch_sub(1, std::memory_order_release);
+        }
+        task();
+    }
+}
+
+ThreadRuntime::ThreadRuntime(const RuntimeConfig& config, size_t venues) {
+    // Parse workers are pinned one per configured CPU, round-robin
+    std::vector<int> parse_cpus = config.parse_cpus;
+    size_t parse_threads = config.parse_threads ? config.parse_threads : parse_cpus.size();
+    WorkStealingPool::configure(parse_threads, [parse_cpus](size_t index) {
+        std::string name = "obk-parse-" + std::to_string(index);
+        thread_util::nameCurrentThread(name);
+        if (!parse_cpus.empty()) {
+            thread_util::pinCurrentThread({parse_cpus[index % parse_cpus.size()]});
+        }
+        thread_util::registerCurrentThread(name);
+    });
+    
+    for (size_t i = 0; i < std::max<size_t>(venues, 1); ++i) {
+        network_.push_back(std::make_unique<PinnedWorker>(
+            "obk-net-" + std::to_string(i), config.network_cpus, false));
+    }
+    book_ = std::make_unique<PinnedWorker>("obk-book", config.book_cpus, config.busy_poll);
+    query_ = std::make_unique<PinnedWorker>("obk-query", config.query_cpus, config.busy_poll);
+}
+
+void ThreadRuntime::report(std::ostream& out) const {
+    out << "Thread context switches (voluntary / involuntary):\n";
+    for (const auto& [name, switches] : thread_util::registeredThreadSwitches()) {
+        out << "  " << name << ": " << switches.voluntary << " / " << switches.involuntary << "\n";
+    }
+}
@@ -0,0 +1,48 @@
+#include "venue_registry.hpp"
+#include "json.hpp"
+#include <fstream>
+#include <iostream>
+
+namespace venues {
+
+std::optional<std::vector<ConfiguredVenue>> enabledVenues(const std::string& config_path) {
+    // If no config file, use defaults
+    if (config_path.empty()) {
+        return std::nullopt;
+    }
+    
+    try {
+        std::ifstream file(config_path);
+        if (!file.is_open()) {
+            std::cerr << "Warning: Could not open config file: " << config_path << "\n";
+            return std::nullopt;
+        }
+        
+        json config;
+        file >> config;
+        
+        if (!config.contains("exchanges")) {
+            throw std::runtime_error("Config missing 'exchanges' array");
+        }
+        
+        std::vector<ConfiguredVenue> venues;
+        for (const auto& exchange : config["exchanges"]) {
+            if (!exchange.value("enabled", false)) {
+                continue;
+            }
+            ConfiguredVenue venue;
+            venue.id = exchange["id"].get<std::string>();
+            if (exchange.contains("order_book_config")) {
+                venue.url = exchange["order_book_config"].value("full_url", "");
+            }
+            venues.push_back(std::move(venue));
+        }
+        return venues;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error parsing config: " << e.what() << "\n";
+        return std::nullopt;
+    }
+}
+
+}  // namespace venues
@@ -0,0 +1,138 @@
+#include "work_stealing_pool.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace {
+
+struct SharedPoolConfig {
+    size_t workers = 0;
+    WorkStealingPool::ThreadInit on_start;
+};
+
+SharedPoolConfig& sharedPoolConfig() {
+    static SharedPoolConfig config;
+    return config;
+}
+
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(size_t workers, ThreadInit on_start) {
+    workers = std::max<size_t>(workers, 1);
+    for (size_t i = 0; i < workers; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < workers; ++i) {
+        threads_.emplace_back([this, i, on_start]() { workerLoop(i, on_start); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_.store(true, std::memory_order_release);
+    }
+    wake_.notify_all();
+    for (auto& t : threads_) {
+        t.join();
+    }
+}
+
+WorkStealingPool& WorkStealingPool::instance() {
+    static WorkStealingPool pool(
+        sharedPoolConfig().workers
+            ? sharedPoolConfig().workers
+            : std::max(1u, std::thread::hardware_concurrency()) - 1,
+        sharedPoolConfig().on_start);
+    return pool;
+}
+
+void WorkStealingPool::configure(size_t workers, ThreadInit on_start) {
+    sharedPoolConfig().workers = workers;
+    sharedPoolConfig().on_start = std::move(on_start);
+}
+
+bool WorkStealingPool::tryRunOne(size_t home) {
+    const size_t n = queues_.size();
+    Task task;
+    
+    // Own deque first (LIFO for cache warmth), then steal FIFO from others
+    for (size_t k = 0; k < n && !task; ++k) {
+        Queue& q = *queues_[(home + k) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) continue;
+        if (k == 0) {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+        } else {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+        }
+    }
+    
+    if (!task) return false;
+    pending_.fetch_sub(1, std::memory_order_acq_rel);
+    task();
+    return true;
+}
+
+void WorkStealingPool::workerLoop(size_t index, const ThreadInit& on_start) {
+    if (on_start) {
+        on_start(index);
+    }
+    
+    while (true) {
+        if (tryRunOne(index)) continue;
+        
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [this]() {
+            return stop_.load(std::memory_order_acquire) ||
+                   pending_.load(std::memory_order_acquire) > 0;
+        });
+        if (stop_.load(std::memory_order_acquire)) return;
+    }
+}
+
+void WorkStealingPool::parallelFor(size_t count, const std::function<void(size_t)>& fn) {
+    if (count == 0) return;
+    
+    struct Shared {
+        std::atomic<size_t> remaining;
+        std::mutex error_mutex;
+        std::exception_ptr error;
+    };
+    auto shared = std::make_shared<Shared>();
+    shared->remaining.store(count, std::memory_order_relaxed);
+    
+    // Count first so a worker can never pop a task that is not yet pending
+    pending_.fetch_add(count, std::memory_order_acq_rel);
+    
+    // Deal tasks round-robin; stealing evens out any imbalance
+    for (size_t i = 0; i < count; ++i) {
+        Queue& q = *queues_[i % queues_.size()];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.emplace_back([shared, &fn, i]() {
+            try {
+                fn(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(shared->error_mutex);
+                if (!shared->error) shared->error = std::current_exception();
+            }
+            shared->remaining.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);  // Pairs with the waiters' predicate check
+    }
+    wake_.notify_all();
+    
+    size_t home = 0;
+    while (shared->remaining.load(std::memory_order_acquire) > 0) {
+        if (!tryRunOne(home++ % queues_.size())) {
+            std::this_thread::yield();
+        }
+    }
+    
+    if (shared->error) {
+        std::rethrow_exception(shared->error);
+    }
+}
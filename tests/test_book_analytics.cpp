@@ -0,0 +1,249 @@
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "../include/book_analytics.hpp"
+#include "../include/order_book.hpp"
+#include "../include/price_calculator.hpp"
+
+static bool sameResult(const ExecutionResult& a, const ExecutionResult& b) {
+    return a.total_cost == b.total_cost && a.quantity_filled == b.quantity_filled &&
+           a.fully_filled == b.fully_filled && a.error == b.error;
+}
+
+// Recomputes every figure from full copies of the book, the way the
+// recorder and PriceCalculator do, and checks the incremental snapshot
+static void expectMatchesRecompute(const OrderBook& book, const BookAnalytics& analytics) {
+    auto bids = book.getBids();
+    auto asks = book.getAsks();
+    LiquiditySnapshot snap = analytics.snapshot();
+
+    if (!bids.empty()) {
+        Quantity size = 0;
+        for (const auto& bid : bids) {
+            if (bid.price == bids.front().price) size += bid.size;
+        }
+        assert(snap.best_bid == bids.front().price && snap.best_bid_size == size);
+        assert(snap.best_bid_venue == bids.front().exchange);
+    }
+    if (!asks.empty()) {
+        Quantity size = 0;
+        for (const auto& ask : asks) {
+            if (ask.price == asks.front().price) size += ask.size;
+        }
+        assert(snap.best_ask == asks.front().price && snap.best_ask_size == size);
+        assert(snap.best_ask_venue == asks.front().exchange);
+    }
+
+    assert(snap.two_sided == (!bids.empty() && !asks.empty()));
+    assert(snap.band_count == analytics.layout().depth_bps.size());
+    if (snap.two_sided) {
+        Price mid = (bids.front().price + asks.front().price) / 2;
+        assert(snap.mid == mid && snap.spread == asks.front().price - bids.front().price);
+        for (size_t k = 0; k < snap.band_count; ++k) {
+            Price band = mid * snap.bands[k].bps / 10000;
+            Quantity bid_depth = 0;
+            Quantity ask_depth = 0;
+            for (const auto& bid : bids) {
+                if (bid.price >= mid - band) bid_depth += bid.size;
+            }
+            for (const auto& ask : asks) {
+                if (ask.price <= mid + band) ask_depth += ask.size;
+            }
+            assert(snap.bands[k].bid_depth == bid_depth);
+            assert(snap.bands[k].ask_depth == ask_depth);
+        }
+    }
+
+    assert(snap.vwap_count == analytics.layout().vwap_sizes.size());
+    for (size_t k = 0; k < snap.vwap_count; ++k) {
+        Quantity size = snap.vwaps[k].size;
+        assert(sameResult(snap.vwaps[k].buy, PriceCalculator::calculateBuyPrice(asks, size)));
+        assert(sameResult(snap.vwaps[k].sell, PriceCalculator::calculateSellPrice(bids, size)));
+    }
+}
+
+static std::vector<PriceLevel> randomLevels(std::mt19937_64& rng, size_t count, Price center, Exchange exchange) {
+    std::vector<PriceLevel> levels;
+    for (size_t i = 0; i < count; ++i) {
+        // Mostly near the touch, a few far outside a small window
+        Price offset = rng() % 10 == 0 ? static_cast<Price>(rng() % 5000) : static_cast<Price>(rng() % 150);
+        levels.emplace_back(center + offset, 1 + static_cast<Quantity>(rng() % 1000), exchange);
+    }
+    return levels;
+}
+
+static std::vector<PriceLevel> mirrored(std::vector<PriceLevel> levels, Price center) {
+    for (auto& level : levels) level.price = std::max<Price>(center - (level.price - center) - 1, 1);
+    return levels;
+}
+
+void test_matches_full_recompute() {
+    std::cout << "=== Testing Snapshot Against Full Recompute ===\n";
+    std::mt19937_64 rng(41);
+    OrderBook book;
+    AnalyticsLayout layout;
+    layout.depth_bps = {5, 100, 2000};
+    layout.vwap_sizes = {1, 500, 20000, 200000};
+    // A 256-tick window so the mid drifts out of it and bands and sizes
+    // reach past it; starting near zero exercises the clamped bid anchor
+    BookAnalytics analytics(book, layout, 256);
+    const Exchange venues[] = {Exchange::COINBASE, Exchange::GEMINI, Exchange::BINANCE, Exchange::KRAKEN};
+
+    for (int step = 0; step < 3000; ++step) {
+        const Price center = 300 + step * 3;
+        Exchange venue = venues[rng() % 4];
+        Price price = center + static_cast<Price>(rng() % 150);
+        Quantity size = static_cast<Quantity>(rng() % 4) * 100;  // 0 removes
+        switch (rng() % 6) {
+            case 0: {
+                auto asks = randomLevels(rng, rng() % 200, center, venue);
+                auto bids = mirrored(randomLevels(rng, rng() % 200, center, venue), center);
+                book.replaceExchange(venue, bids, asks);
+                break;
+            }
+            case 1:
+                book.mergeBids(mirrored(randomLevels(rng, rng() % 20, center, venue), center));
+                break;
+            case 2:
+                book.addAsk(price, size + 1, venue);
+                break;
+            case 3:
+                book.setBidLevel(std::max<Price>(2 * center - price, 1), size, venue);
+                break;
+            default:
+                book.setAskLevel(price, size, venue);
+                break;
+        }
+        if (step == 1500) {
+            book.clear();
+        }
+        expectMatchesRecompute(book, analytics);
+    }
+    assert(analytics.snapshot().sequence > 3000);
+    assert(analytics.rebuilds() > 2 && analytics.fallbacks() > 0);
+    std::cout << "  " << analytics.rebuilds() << " rebuilds, " << analytics.fallbacks() << " fallbacks\n";
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_touch_edits_stay_incremental() {
+    std::cout << "=== Testing Top-Of-Book Edits Stay Incremental ===\n";
+    OrderBook book;
+    std::vector<PriceLevel> bids;
+    std::vector<PriceLevel> asks;
+    for (Price i = 0; i < 2000; ++i) {
+        bids.emplace_back(9999900 - i * 5, QUANTITY_SCALE / 4, Exchange::COINBASE);
+        asks.emplace_back(10000100 + i * 5, QUANTITY_SCALE / 4, Exchange::COINBASE);
+    }
+    // A whale level whose notional alone overflows int64
+    asks.emplace_back(10020000, 20000 * QUANTITY_SCALE, Exchange::COINBASE);
+    book.replaceExchange(Exchange::COINBASE, bids, asks);
+    book.replaceExchange(Exchange::KRAKEN, {PriceLevel(9999950, QUANTITY_SCALE, Exchange::KRAKEN)},
+                         {PriceLevel(10000050, QUANTITY_SCALE, Exchange::KRAKEN)});
+
+    AnalyticsLayout layout;
+    layout.vwap_sizes.push_back(15000 * QUANTITY_SCALE);
+    BookAnalytics analytics(book, layout);
+    expectMatchesRecompute(book, analytics);
+    const uint64_t rebuilds = analytics.rebuilds();
+
+    std::mt19937_64 rng(7);
+    for (int step = 0; step < 2000; ++step) {
+        Price price = 10000050 + static_cast<Price>(rng() % 400);
+        book.setAskLevel(price, static_cast<Quantity>(rng() % 3) * QUANTITY_SCALE, Exchange::GEMINI);
+        book.setBidLevel(price - 500, static_cast<Quantity>(rng() % 3) * QUANTITY_SCALE, Exchange::GEMINI);
+        if (step % 20 == 0) expectMatchesRecompute(book, analytics);
+    }
+    expectMatchesRecompute(book, analytics);
+    assert(analytics.rebuilds() == rebuilds && analytics.fallbacks() == 0);
+
+    LiquiditySnapshot snap = analytics.snapshot();
+    assert(snap.best_ask == 10000050 && snap.best_ask_venue == Exchange::KRAKEN);
+    assert(snap.vwaps[3].buy.fully_filled && snap.vwaps[3].buy.total_cost > INT64_MAX / QUANTITY_SCALE);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+// Counts what a listener is told, to check replaces only report net changes
+struct CountingListener : BookListener {
+    size_t resets = 0;
+    size_t levels = 0;
+    size_t commits = 0;
+    Quantity net = 0;
+
+    void onReset(const BookSideView&, const BookSideView&) override { ++resets; }
+    void onLevel(Side, Price, Quantity delta) override { ++levels; net += delta; }
+    void onCommit(const BookSideView&, const BookSideView&) override { ++commits; }
+};
+
+void test_replace_reports_net_changes() {
+    std::cout << "=== Testing Replace Reports Only Changed Levels ===\n";
+    OrderBook book;
+    std::vector<PriceLevel> asks;
+    for (Price i = 0; i < 1000; ++i) asks.emplace_back(10000 + i, 100, Exchange::BINANCE);
+    book.replaceExchange(Exchange::BINANCE, {}, asks);
+
+    CountingListener listener;
+    book.setListener(&listener);
+    assert(listener.resets == 1);
+
+    asks[10].size = 150;           // One size change
+    asks.erase(asks.begin() + 20); // One level gone
+    asks.emplace_back(9990, 5, Exchange::BINANCE);  // One new level, out of order
+    book.replaceExchange(Exchange::BINANCE, {}, asks);
+    assert(listener.levels == 3 && listener.net == 50 - 100 + 5 && listener.commits == 1);
+
+    book.setAskLevel(10500, 100, Exchange::BINANCE);  // Unchanged size
+    book.setAskLevel(10500, 0, Exchange::BINANCE);
+    assert(listener.levels == 4 && listener.commits == 3);
+
+    book.clear();
+    assert(listener.resets == 2);
+    book.setListener(nullptr);
+    book.addAsk(10000, 1, Exchange::BINANCE);
+    assert(listener.levels == 4);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_one_sided_and_detach() {
+    std::cout << "=== Testing One-Sided Book And Detach ===\n";
+    OrderBook book;
+    {
+        BookAnalytics analytics(book);
+        LiquiditySnapshot empty = analytics.snapshot();
+        assert(!empty.two_sided && empty.vwaps[0].buy.error == ErrorCode::NO_ASKS);
+        assert(empty.vwaps[0].sell.error == ErrorCode::NO_BIDS);
+
+        book.addBid(9000000, QUANTITY_SCALE / 2, Exchange::GEMINI);
+        LiquiditySnapshot bids_only = analytics.snapshot();
+        assert(!bids_only.two_sided && bids_only.best_bid == 9000000 && bids_only.mid == 0);
+        assert(bids_only.bands[0].bid_depth == 0);
+        assert(bids_only.vwaps[0].sell.error == ErrorCode::INSUFFICIENT_LIQUIDITY);
+        assert(bids_only.vwaps[0].sell.quantity_filled == QUANTITY_SCALE / 2);
+        expectMatchesRecompute(book, analytics);
+
+        bool threw = false;
+        try {
+            AnalyticsLayout bad;
+            bad.depth_bps = {0};
+            OrderBook other;
+            BookAnalytics invalid(other, bad);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    // Analytics detached on destruction; the book keeps working
+    book.addAsk(9100000, 1, Exchange::GEMINI);
+    assert(book.askDepth() == 1);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+int main() {
+    test_matches_full_recompute();
+    test_touch_edits_stay_incremental();
+    test_replace_reports_net_changes();
+    test_one_sided_and_detach();
+    std::cout << "All tests passed! ✓\n";
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include "../include/book_checkpoint.hpp"
+#include "../include/content_hash.hpp"
+
+static std::string tempPath(const char* name) {
+    return "/tmp/" + std::string(name) + "_" + std::to_string(::getpid()) + ".obksnap";
+}
+
+void test_round_trip() {
+    std::cout << "=== Testing Checkpoint Round Trip ===\n";
+    OrderBook book;
+    for (int i = 0; i < 500; ++i) {
+        book.addBid(9999000 - i * 100, QUANTITY_SCALE + i, i % 2 ? Exchange::GEMINI : Exchange::COINBASE);
+        book.addAsk(10001000 + i * 100, 2 * QUANTITY_SCALE + i, i % 2 ? Exchange::GEMINI : Exchange::COINBASE);
+    }
+    
+    auto venues = book_checkpoint::splitByVenue(
+        book, {{Exchange::COINBASE, 111}, {Exchange::GEMINI, 222}});
+    assert(venues.size() == 2 && venues[0].bids.size() == 250);
+    
+    std::string path = tempPath("checkpoint_round_trip");
+    assert(book_checkpoint::save(path, venues, 333));
+    
+    std::vector<VenueBook> loaded;
+    int64_t written_us = 0;
+    assert(book_checkpoint::load(path, loaded, written_us));
+    assert(written_us == 333 && loaded.size() == 2);
+    assert(loaded[1].exchange == Exchange::GEMINI && loaded[1].timestamp_us == 222);
+    
+    OrderBook restored;
+    for (const auto& venue : loaded) {
+        restored.replaceExchange(venue.exchange, venue.bids, venue.asks);
+    }
+    auto a = book.getAsks();
+    auto b = restored.getAsks();
+    assert(a.size() == b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        assert(a[i].price == b[i].price && a[i].size == b[i].size && a[i].exchange == b[i].exchange);
+    }
+    assert(restored.bidDepth() == book.bidDepth());
+    
+    std::remove(path.c_str());
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_rejects_corruption() {
+    std::cout << "=== Testing Corrupt Checkpoint Rejection ===\n";
+    std::string path = tempPath("checkpoint_corrupt");
+    VenueBook venue;
+    venue.exchange = Exchange::COINBASE;
+    venue.timestamp_us = 1;
+    venue.asks.emplace_back(10000000, QUANTITY_SCALE, Exchange::COINBASE);
+    assert(book_checkpoint::save(path, {venue}, 1));
+    
+    // Flip a byte in the level payload
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-10, std::ios::end);
+        file.put('\x7f');
+    }
+    std::vector<VenueBook> loaded;
+    int64_t written_us = 0;
+    assert(!book_checkpoint::load(path, loaded, written_us));
+    
+    // Truncated file
+    assert(book_checkpoint::save(path, {venue}, 1));
+    assert(::truncate(path.c_str(), 60) == 0);
+    assert(!book_checkpoint::load(path, loaded, written_us));
+    
+    // Counts that only match the file size after wrapping, with a valid
+    // checksum: must be rejected before any level is read
+    using namespace checkpoint_format;
+    venue.bids.emplace_back(9990000, QUANTITY_SCALE, Exchange::COINBASE);
+    assert(book_checkpoint::save(path, {venue}, 1));
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        Header header;
+        VenueEntry entry;
+        Level levels[2];
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        file.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+        file.read(reinterpret_cast<char*>(levels), sizeof(levels));
+        header.level_count += uint64_t{1} << 61;  // * sizeof(Level) wraps back
+        entry.ask_offset = 0;
+        entry.ask_count = uint64_t{1} << 40;
+        uint64_t hash = content_hash::xxh64(&entry, sizeof(entry));
+        header.payload_hash = content_hash::xxh64(levels, sizeof(levels), hash);
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    }
+    assert(!book_checkpoint::load(path, loaded, written_us));
+    
+    assert(!book_checkpoint::load("/nonexistent/book.obksnap", loaded, written_us));
+    std::remove(path.c_str());
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_background_writer() {
+    std::cout << "=== Testing Background Checkpoint Writer ===\n";
+    std::string path = tempPath("checkpoint_background");
+    VenueBook venue;
+    venue.exchange = Exchange::KRAKEN;
+    venue.timestamp_us = 7;
+    for (int i = 0; i < 1000; ++i) {
+        venue.bids.emplace_back(9999000 - i, QUANTITY_SCALE, Exchange::KRAKEN);
+    }
+    
+    std::vector<VenueBook> loaded;
+    int64_t written_us = 0;
+    {
+        book_checkpoint::BackgroundWriter writer(path);
+        assert(!writer.busy());
+        writer.submit({venue}, 1);
+        writer.wait();
+        assert(!writer.busy() && writer.saved() == 1 && writer.failed() == 0);
+        assert(book_checkpoint::load(path, loaded, written_us) && written_us == 1);
+        assert(loaded.size() == 1 && loaded[0].bids.size() == 1000);
+        
+        // A second submit waits for the first; the destructor for the last
+        writer.submit({venue}, 2);
+        venue.bids.erase(venue.bids.begin() + 10, venue.bids.end());
+        writer.submit({venue}, 3);
+    }
+    assert(book_checkpoint::load(path, loaded, written_us) && written_us == 3);
+    assert(loaded[0].bids.size() == 10 && loaded[0].timestamp_us == 7);
+    
+    book_checkpoint::BackgroundWriter unwritable("/nonexistent/dir/book.obksnap");
+    unwritable.submit({venue}, 4);
+    unwritable.wait();
+    assert(unwritable.saved() == 0 && unwritable.failed() == 1);
+    std::remove(path.c_str());
+    std::cout << "  ✓ PASS\n\n";
+}
+
+int main() {
+    test_round_trip();
+    test_rejects_corruption();
+    test_background_writer();
+    std::cout << "All tests passed! ✓\n";
+    return 0;
+}
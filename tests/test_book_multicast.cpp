@@ -0,0 +1,344 @@
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../include/book_multicast.hpp"
+
+// ctest treats this as "skipped" (sandboxes without a multicast route)
+constexpr int kSkip = 77;
+
+static bool sameBook(const OrderBook& a, const OrderBook& b) {
+    // Equal-price levels from different venues may come back in either order
+    auto normalise = [](std::vector<PriceLevel> levels) {
+        std::sort(levels.begin(), levels.end(), [](const PriceLevel& x, const PriceLevel& y) {
+            return x.price != y.price ? x.price < y.price : x.exchange < y.exchange;
+        });
+        return levels;
+    };
+    auto same = [&](const std::vector<PriceLevel>& x, const std::vector<PriceLevel>& y) {
+        auto nx = normalise(x);
+        auto ny = normalise(y);
+        if (nx.size() != ny.size()) return false;
+        for (size_t i = 0; i < nx.size(); ++i) {
+            if (nx[i].price != ny[i].price || nx[i].size != ny[i].size ||
+                nx[i].exchange != ny[i].exchange) return false;
+        }
+        return true;
+    };
+    return same(a.getBids(), b.getBids()) && same(a.getAsks(), b.getAsks());
+}
+
+// Deterministic book evolution shared by publisher and forked receivers
+static void buildStep(OrderBook& book, int step) {
+    book.clear();
+    for (int i = 0; i < 150; ++i) {
+        Exchange ex = (i % 3 == 0) ? Exchange::GEMINI : Exchange::COINBASE;
+        int bump = (i % 4 == step % 4) ? step * 13 : 0;  // A quarter of levels resize per step
+        Quantity size = QUANTITY_SCALE + ((i * 7 + bump) % 50) * 1000000;
+        if ((i + step) % 11 == 0) continue;  // Levels come and go between steps
+        book.addBid(9999000 - i * 100, size, ex);
+        book.addAsk(10001000 + i * 100, size, ex);
+    }
+}
+
+void test_delta_round_trip() {
+    std::cout << "=== Testing Snapshot + Delta Reconstruction ===\n";
+    BookMulticastReceiver receiver;
+    BookMulticastPublisher publisher([&receiver](const uint8_t* data, size_t len) {
+        assert(len <= multicast_format::kMaxDatagram);
+        receiver.handlePacket(data, len);
+    });
+    
+    OrderBook book;
+    buildStep(book, 0);
+    publisher.publishSnapshot(book);
+    assert(receiver.synced());
+    assert(sameBook(book, receiver.book()));
+    
+    for (int step = 1; step < 10; ++step) {
+        buildStep(book, step);
+        size_t changed = publisher.publishDelta(book);
+        assert(changed > 0 && changed < 300);
+        assert(sameBook(book, receiver.book()));
+    }
+    assert(publisher.publishDelta(book) == 0);  // Nothing changed, nothing sent
+    assert(receiver.gaps() == 0 && receiver.malformed() == 0);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_gap_recovery() {
+    std::cout << "=== Testing Sequence Gap Recovery ===\n";
+    BookMulticastReceiver receiver;
+    bool drop = false;
+    BookMulticastPublisher publisher([&](const uint8_t* data, size_t len) {
+        if (!drop) receiver.handlePacket(data, len);
+    });
+    
+    OrderBook book;
+    buildStep(book, 0);
+    publisher.publishSnapshot(book);
+    assert(receiver.synced());
+    
+    drop = true;  // Lose one delta
+    buildStep(book, 1);
+    publisher.publishDelta(book);
+    drop = false;
+    
+    buildStep(book, 2);
+    publisher.publishDelta(book);
+    assert(receiver.gaps() == 1);
+    assert(!receiver.synced());  // Must not apply deltas on top of a hole
+    
+    buildStep(book, 3);
+    publisher.publishDelta(book);
+    assert(!receiver.synced());
+    
+    publisher.publishSnapshot(book);
+    assert(receiver.synced());
+    assert(sameBook(book, receiver.book()));
+    
+    buildStep(book, 4);
+    publisher.publishDelta(book);
+    assert(sameBook(book, receiver.book()));
+    
+    // Garbage is counted, not applied
+    uint8_t junk[40] = {1, 2, 3};
+    receiver.handlePacket(junk, sizeof(junk));
+    assert(receiver.malformed() == 1 && receiver.synced());
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_publisher_restart() {
+    std::cout << "=== Testing Publisher Restart Resync ===\n";
+    BookMulticastReceiver receiver;
+    auto deliver = [&receiver](const uint8_t* data, size_t len) { receiver.handlePacket(data, len); };
+    
+    OrderBook book;
+    uint64_t first_session = 0;
+    {
+        BookMulticastPublisher first(deliver);
+        first_session = first.session();
+        buildStep(book, 0);
+        first.publishSnapshot(book);
+        for (int step = 1; step < 6; ++step) {
+            buildStep(book, step);
+            first.publishDelta(book);
+        }
+        assert(receiver.synced() && sameBook(book, receiver.book()));
+    }
+    
+    // The replacement numbers its packets from 1 again
+    BookMulticastPublisher second(deliver);
+    assert(second.session() != first_session);
+    buildStep(book, 6);
+    second.publishDelta(book);
+    assert(receiver.restarts() == 1 && receiver.gaps() == 0);
+    assert(!receiver.synced());  // Its deltas are against a base we never saw
+    
+    second.publishSnapshot(book);
+    assert(receiver.synced() && sameBook(book, receiver.book()));
+    assert(receiver.lastSequence() == second.packetsSent());
+    buildStep(book, 7);
+    second.publishDelta(book);
+    assert(sameBook(book, receiver.book()) && receiver.restarts() == 1);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+// Forked receivers each join the group and must end with the publisher's book
+int test_loopback_fanout() {
+    std::cout << "=== Testing Loopback Multicast Fan-out ===\n";
+    MulticastEndpoint endpoint;
+    endpoint.group = "239.255.42.99";
+    endpoint.port = static_cast<uint16_t>(31000 + ::getpid() % 20000);
+    endpoint.interface_addr = "127.0.0.1";
+    
+    constexpr int kReceivers = 3;
+    constexpr int kSteps = 20;
+    
+    std::unique_ptr<BookMulticastPublisher> publisher;
+    try {
+        publisher = std::make_unique<BookMulticastPublisher>(endpoint);
+        BookMulticastReceiver probe(endpoint);
+    } catch (const std::exception& e) {
+        std::cout << "  - SKIP: " << e.what() << "\n\n";
+        return kSkip;
+    }
+    
+    int ready[2];
+    assert(::pipe(ready) == 0);
+    std::vector<pid_t> children;
+    for (int r = 0; r < kReceivers; ++r) {
+        pid_t pid = ::fork();
+        assert(pid >= 0);
+        if (pid == 0) {
+            ::close(ready[0]);
+            BookMulticastReceiver receiver(endpoint);
+            char token = 'r';
+            (void)!::write(ready[1], &token, 1);
+            
+            OrderBook expected;
+            buildStep(expected, kSteps - 1);
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (std::chrono::steady_clock::now() < deadline) {
+                receiver.poll(100);
+                if (receiver.synced() && sameBook(expected, receiver.book())) {
+                    ::_exit(0);
+                }
+            }
+            ::_exit(1);
+        }
+        children.push_back(pid);
+    }
+    ::close(ready[1]);
+    for (int r = 0; r < kReceivers; ++r) {
+        char token;
+        assert(::read(ready[0], &token, 1) == 1);
+    }
+    ::close(ready[0]);
+    
+    OrderBook book;
+    for (int step = 0; step < kSteps; ++step) {
+        buildStep(book, step);
+        if (step % 5 == 0) {
+            publisher->publishSnapshot(book);
+        } else {
+            publisher->publishDelta(book);
+        }
+        ::usleep(2000);
+    }
+    publisher->publishSnapshot(book);  // Lets any receiver that saw a drop resync
+    assert(publisher->packetsSent() > kSteps);
+    
+    int passed = 0;
+    for (pid_t pid : children) {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0) ++passed;
+    }
+    assert(passed == kReceivers);
+    std::cout << "  ✓ PASS (" << kReceivers << " receivers, "
+              << publisher->packetsSent() << " packets)\n\n";
+    return 0;
+}
+
+// Forked receivers must follow the feed across a publisher process that
+// exits and is replaced by a new one starting again at sequence 1
+int test_loopback_publisher_restart() {
+    std::cout << "=== Testing Loopback Publisher Process Restart ===\n";
+    MulticastEndpoint endpoint;
+    endpoint.group = "239.255.42.99";
+    endpoint.port = static_cast<uint16_t>(51000 + ::getpid() % 10000);
+    endpoint.interface_addr = "127.0.0.1";
+    
+    constexpr int kReceivers = 3;
+    constexpr int kSteps = 20;
+    constexpr int kRestartSteps = 5;
+    constexpr int kRestartBase = 100;  // The second publisher's book differs
+    
+    try {
+        BookMulticastPublisher probe_publisher(endpoint);
+        BookMulticastReceiver probe(endpoint);
+    } catch (const std::exception& e) {
+        std::cout << "  - SKIP: " << e.what() << "\n\n";
+        return kSkip;
+    }
+    
+    // Receivers report once when joined and once when synced to the first
+    // publisher, then exit 0 once synced to the second
+    int ready[2];
+    assert(::pipe(ready) == 0);
+    std::vector<pid_t> children;
+    for (int r = 0; r < kReceivers; ++r) {
+        pid_t pid = ::fork();
+        assert(pid >= 0);
+        if (pid == 0) {
+            ::close(ready[0]);
+            BookMulticastReceiver receiver(endpoint);
+            char token = 'r';
+            (void)!::write(ready[1], &token, 1);
+            
+            OrderBook first;
+            OrderBook second;
+            buildStep(first, kSteps - 1);
+            buildStep(second, kRestartBase + kRestartSteps - 1);
+            bool on_first = false;
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (std::chrono::steady_clock::now() < deadline) {
+                receiver.poll(100);
+                if (!on_first && receiver.synced() && sameBook(first, receiver.book())) {
+                    on_first = true;
+                    (void)!::write(ready[1], &token, 1);
+                }
+                if (on_first && receiver.synced() && receiver.restarts() == 1 &&
+                    sameBook(second, receiver.book())) {
+                    ::_exit(0);
+                }
+            }
+            ::_exit(1);
+        }
+        children.push_back(pid);
+    }
+    ::close(ready[1]);
+    auto awaitReceivers = [&]() {
+        for (int r = 0; r < kReceivers; ++r) {
+            char token;
+            assert(::read(ready[0], &token, 1) == 1);
+        }
+    };
+    
+    // Each publisher is its own process, so the second really starts afresh
+    auto runPublisher = [&](int base, int steps) {
+        pid_t pid = ::fork();
+        assert(pid >= 0);
+        if (pid == 0) {
+            BookMulticastPublisher publisher(endpoint);
+            OrderBook book;
+            for (int step = 0; step < steps; ++step) {
+                buildStep(book, base + step);
+                if (step % 5 == 0) {
+                    publisher.publishSnapshot(book);
+                } else {
+                    publisher.publishDelta(book);
+                }
+                ::usleep(2000);
+            }
+            publisher.publishSnapshot(book);
+            ::_exit(0);
+        }
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    };
+    
+    awaitReceivers();
+    runPublisher(0, kSteps);
+    awaitReceivers();
+    runPublisher(kRestartBase, kRestartSteps);  // Fewer packets than the first sent
+    ::close(ready[0]);
+    
+    int passed = 0;
+    for (pid_t pid : children) {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0) ++passed;
+    }
+    assert(passed == kReceivers);
+    std::cout << "  ✓ PASS (" << kReceivers << " receivers)\n\n";
+    return 0;
+}
+
+int main() {
+    test_delta_round_trip();
+    test_gap_recovery();
+    test_publisher_restart();
+    if (test_loopback_fanout() == kSkip || test_loopback_publisher_restart() == kSkip) {
+        return kSkip;
+    }
+    std::cout << "All tests passed! ✓\n";
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include <iostream>
+#include <cassert>
+#include <sstream>
+#include <stdexcept>
+#include "../include/book_parser.hpp"
+
+static std::string coinbaseBody(size_t depth) {
+    std::ostringstream ss;
+    ss << "{\"bids\":[";
+    for (size_t i = 0; i < depth; ++i) {
+        ss << (i ? "," : "") << "[\"" << 100000 - i * 0.5 << "\",\"0." << (i % 97 + 1) << "\",3]";
+    }
+    ss << "],\"asks\":[";
+    for (size_t i = 0; i < depth; ++i) {
+        ss << (i ? ", " : "") << "[\"" << 100001 + i * 0.5 << "\",\"1." << (i % 89) << "\",1]";
+    }
+    ss << "],\"sequence\":12345,\"auction_mode\":false}";
+    return ss.str();
+}
+
+static std::string geminiBody(size_t depth) {
+    std::ostringstream ss;
+    ss << "{\"bids\": [";
+    for (size_t i = 0; i < depth; ++i) {
+        ss << (i ? "," : "") << "{\"price\":\"" << 99999 - i << ".25\",\"amount\":\"0.0" << (i % 9 + 1)
+           << "\",\"timestamp\":\"1700000000\"}";
+    }
+    ss << "], \"asks\": [";
+    for (size_t i = 0; i < depth; ++i) {
+        ss << (i ? "," : "") << "{\"price\":\"" << 100001 + i << ".75\",\"amount\":\"2\",\"timestamp\":\"1700000000\"}";
+    }
+    ss << "]}";
+    return ss.str();
+}
+
+static void assertSame(const OrderBookSnapshot& a, const OrderBookSnapshot& b) {
+    assert(a.bids.size() == b.bids.size());
+    assert(a.asks.size() == b.asks.size());
+    for (size_t i = 0; i < a.bids.size(); ++i) {
+        assert(a.bids[i].price == b.bids[i].price && a.bids[i].size == b.bids[i].size);
+    }
+    for (size_t i = 0; i < a.asks.size(); ++i) {
+        assert(a.asks[i].price == b.asks[i].price && a.asks[i].size == b.asks[i].size);
+    }
+}
+
+void test_chunked_matches_serial() {
+    std::cout << "=== Testing Chunked Parse Matches Serial ===\n";
+    struct Case { std::string body; book_parser::LevelConverter convert; };
+    for (const Case& c : {Case{coinbaseBody(3000), book_parser::arrayLevel},
+                          Case{geminiBody(3000), book_parser::objectLevel}}) {
+        OrderBookSnapshot serial;
+        book_parser::parseBookSerial(c.body, Exchange::COINBASE, c.convert, serial);
+        assert(serial.bids.size() == 3000 && serial.asks.size() == 3000);
+        
+        // Tiny chunks force many cuts inside both arrays
+        for (size_t chunk : {1u, 100u, 4096u}) {
+            OrderBookSnapshot parallel;
+            book_parser::parseBookParallel(c.body, Exchange::COINBASE, c.convert, parallel, chunk);
+            assertSame(serial, parallel);
+        }
+    }
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_empty_and_malformed() {
+    std::cout << "=== Testing Empty and Malformed Bodies ===\n";
+    OrderBookSnapshot empty;
+    assert(book_parser::parseBookParallel("{\"bids\":[],\"asks\":[ ]}", Exchange::GEMINI,
+                                          book_parser::objectLevel, empty, 1) == ErrorCode::OK);
+    assert(empty.bids.empty() && empty.asks.empty());
+    
+    // Failures come back as codes, never as exceptions
+    OrderBookSnapshot bad;
+    assert(book_parser::parseBookParallel("{\"bids\":[[\"1\",\"2\",1],[\"oops\"]],\"asks\":[]}",
+                                          Exchange::COINBASE, book_parser::arrayLevel, bad, 1)
+           == ErrorCode::MALFORMED_LEVEL);
+    
+    OrderBookSnapshot html;
+    assert(book_parser::parseBook("<html>503 Service Unavailable</html>", Exchange::COINBASE,
+                                  book_parser::arrayLevel, html) == ErrorCode::MALFORMED_JSON);
+    
+    OrderBookSnapshot gemini;
+    assert(book_parser::parseBookSerial("{\"bids\":[{\"price\":\"1.5\"}],\"asks\":[]}",
+                                        Exchange::GEMINI, book_parser::objectLevel, gemini)
+           == ErrorCode::MALFORMED_LEVEL);
+    assert(book_parser::parseBookSerial("{\"bids\":[[\"abc\",\"1\"]],\"asks\":[]}",
+                                        Exchange::COINBASE, book_parser::arrayLevel, gemini)
+           == ErrorCode::MALFORMED_LEVEL);
+    
+    // strtod accepts these, but converting them to fixed point is undefined
+    for (const char* number : {"nan", "NaN", "inf", "-inf", "infinity", "1e999", "1e300",
+                               "0x1p3", "-0X10", " 1.5", "\\t1.5", "-", "", "+1.5"}) {
+        OrderBookSnapshot coinbase;
+        std::string array = std::string("{\"bids\":[[\"") + number + "\",\"1\",1]],\"asks\":[]}";
+        assert(book_parser::parseBookSerial(array, Exchange::COINBASE, book_parser::arrayLevel, coinbase)
+               == ErrorCode::MALFORMED_LEVEL);
+        OrderBookSnapshot object;
+        std::string amount = std::string("{\"bids\":[],\"asks\":[{\"price\":\"1.5\",\"amount\":\"") + number + "\"}]}";
+        assert(book_parser::parseBookSerial(amount, Exchange::GEMINI, book_parser::objectLevel, object)
+               == ErrorCode::MALFORMED_LEVEL);
+    }
+    OrderBookSnapshot plain;
+    assert(book_parser::parseBookSerial("{\"bids\":[[\"-0.5\",\".25\",1],[\"1e2\",\"0\",1]],\"asks\":[]}",
+                                        Exchange::COINBASE, book_parser::arrayLevel, plain) == ErrorCode::OK);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+int main() {
+    test_chunked_matches_serial();
+    test_empty_and_malformed();
+    std::cout << "All tests passed! ✓\n";
+    return 0;
+}
@@ -0,0 +1,258 @@
+#include <iostream>
+#include <cassert>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <unistd.h>
+#include "../include/book_recorder.hpp"
+
+static std::string tempPath(const char* name) {
+    return "/tmp/" + std::string(name) + "_" + std::to_string(::getpid()) + ".obkrec";
+}
+
+void test_round_trip() {
+    std::cout << "=== Testing Recorder Round Trip ===\n";
+    std::string path = tempPath("recorder_round_trip");
+    RecorderLayout layout;
+    layout.venues = {Exchange::COINBASE, Exchange::GEMINI};
+    const size_t columns = layout.columns();
+    
+    std::mt19937_64 rng(5);
+    std::uniform_int_distribution<int64_t> jitter(-500, 500);
+    std::vector<int64_t> expected;
+    std::vector<int64_t> row(columns);
+    for (size_t r = 0; r < 10007; ++r) {  // Not a multiple of the block size
+        row[0] = 1700000000000000 + static_cast<int64_t>(r) * 2000000;
+        for (size_t c = 1; c < columns; ++c) {
+            row[c] = (r == 0 ? 10000000 : expected[(r - 1) * columns + c]) + jitter(rng);
+        }
+        expected.insert(expected.end(), row.begin(), row.end());
+    }
+    
+    {
+        BookRecorder recorder(path, layout, 1000);
+        for (size_t r = 0; r < expected.size() / columns; ++r) {
+            recorder.record(expected.data() + r * columns);
+        }
+        recorder.flush();
+        assert(recorder.rowsWritten() == 10007);
+    }
+    
+    RecordingReader reader(path);
+    assert(reader.layout().columns() == columns);
+    assert(reader.layout().venues[1] == Exchange::GEMINI);
+    
+    size_t seen = 0;
+    uint64_t total = reader.forEachRow([&](const int64_t* values, size_t rows, size_t r) {
+        for (size_t c = 0; c < columns; ++c) {
+            assert(values[c * rows + r] == expected[seen * columns + c]);
+        }
+        ++seen;
+    });
+    assert(total == 10007 && seen == 10007);
+    
+    // Single-column scan
+    reader.rewind();
+    std::vector<int64_t> ts;
+    size_t rows = 0;
+    size_t at = 0;
+    while (reader.nextBlockColumn(0, ts, rows)) {
+        for (size_t r = 0; r < rows; ++r, ++at) {
+            assert(ts[r] == expected[at * columns]);
+        }
+    }
+    assert(at == 10007);
+    
+    std::remove(path.c_str());
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_summarize_book() {
+    std::cout << "=== Testing Book Summary Row ===\n";
+    OrderBook book;
+    book.addBid(9999000, QUANTITY_SCALE, Exchange::COINBASE);
+    book.addBid(9990000, 2 * QUANTITY_SCALE, Exchange::GEMINI);
+    book.addAsk(10001000, QUANTITY_SCALE, Exchange::GEMINI);
+    book.addAsk(10100000, 20 * QUANTITY_SCALE, Exchange::COINBASE);
+    
+    RecorderLayout layout;
+    layout.venues = {Exchange::COINBASE, Exchange::GEMINI};
+    layout.depth_bps = {5};
+    layout.curve_sizes = {QUANTITY_SCALE};
+    
+    std::vector<int64_t> row;
+    layout.summarize(book, 42, row);
+    assert(row.size() == layout.columns());
+    assert(row[0] == 42);
+    assert(row[1] == 9999000 && row[2] == 10100000);   // Coinbase bid/ask
+    assert(row[3] == 9990000 && row[4] == 10001000);   // Gemini bid/ask
+    assert(row[5] == QUANTITY_SCALE && row[6] == QUANTITY_SCALE);  // Within 5 bps of mid
+    assert(row[7] == 10001000 && row[8] == 9999000);   // 1 BTC buy/sell cost
+    assert(layout.columnName(3) == "Gemini.best_bid");
+    std::cout << "  ✓ PASS\n\n";
+}
+
+static std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream out;
+    out << in.rdbuf();
+    return out.str();
+}
+
+static void writeFile(const std::string& path, const std::string& bytes) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+}
+
+static bool opens(const std::string& path) {
+    try {
+        RecordingReader reader(path);
+        return true;
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+}
+
+// Reads every block; false if a block was rejected as corrupt
+static bool readsCleanly(const std::string& path, uint64_t& rows_read) {
+    RecordingReader reader(path);
+    rows_read = 0;
+    try {
+        rows_read = reader.forEachRow([](const int64_t*, size_t, size_t) {});
+        return true;
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+}
+
+void test_rejects_damage() {
+    std::cout << "=== Testing Truncated And Corrupt Recordings ===\n";
+    std::string path = tempPath("recorder_damage");
+    std::string damaged = tempPath("recorder_damaged");
+    RecorderLayout layout;
+    layout.venues = {Exchange::COINBASE};
+    const size_t columns = layout.columns();
+    {
+        BookRecorder recorder(path, layout, 1000);
+        std::vector<int64_t> row(columns);
+        for (int64_t r = 0; r < 3000; ++r) {
+            for (size_t c = 0; c < columns; ++c) row[c] = r * 1000 + static_cast<int64_t>(c);
+            recorder.record(row.data());
+        }
+    }
+    const std::string good = readFile(path);
+    const size_t data_start = sizeof(recorder_format::FileHeader) + layout.venues.size() +
+                              layout.depth_bps.size() * sizeof(int32_t) +
+                              layout.curve_sizes.size() * sizeof(Quantity);
+    uint64_t rows = 0;
+    assert(readsCleanly(path, rows) && rows == 3000);
+    
+    // Killed mid-header: the tables the header promises are not all there
+    for (size_t cut : {sizeof(recorder_format::FileHeader), data_start - 1}) {
+        writeFile(damaged, good.substr(0, cut));
+        assert(!opens(damaged));
+    }
+    
+    // Header counts that disagree with the file or with each other
+    auto withHeader = [&](auto mutate) {
+        std::string bytes = good;
+        recorder_format::FileHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        mutate(header);
+        std::memcpy(&bytes[0], &header, sizeof(header));
+        writeFile(damaged, bytes);
+    };
+    withHeader([](recorder_format::FileHeader& h) { h.venue_count = 0xFFFFFFFF; });
+    assert(!opens(damaged));
+    withHeader([](recorder_format::FileHeader& h) { h.size_count = 0x7FFFFFFF; });
+    assert(!opens(damaged));
+    withHeader([](recorder_format::FileHeader& h) { h.columns += 1; });
+    assert(!opens(damaged));
+    
+    // A torn last block ends the recording early without an error
+    writeFile(damaged, good.substr(0, good.size() - 5));
+    assert(readsCleanly(damaged, rows) && rows == 2000);
+    
+    // Blocks whose column table or data lie about their sizes
+    auto withBlock = [&](auto mutate) {
+        std::string bytes = good;
+        mutate(reinterpret_cast<uint8_t*>(&bytes[data_start]));
+        writeFile(damaged, bytes);
+    };
+    auto table = [](uint8_t* block, size_t c) {
+        return reinterpret_cast<uint32_t*>(block + sizeof(recorder_format::BlockHeader) + c * sizeof(uint32_t));
+    };
+    withBlock([&](uint8_t* block) { *table(block, 0) = 0x7FFFFFFF; });
+    assert(!readsCleanly(damaged, rows));
+    withBlock([&](uint8_t* block) { *table(block, 0) += 1; *table(block, 1) -= 1; });
+    assert(!readsCleanly(damaged, rows));  // Sizes still sum right; a varint straddles
+    withBlock([](uint8_t* block) { reinterpret_cast<recorder_format::BlockHeader*>(block)->rows = 1u << 30; });
+    assert(!readsCleanly(damaged, rows));
+    withBlock([](uint8_t* block) { reinterpret_cast<recorder_format::BlockHeader*>(block)->payload_bytes = 4; });
+    assert(!readsCleanly(damaged, rows));
+    withBlock([&](uint8_t* block) {
+        // Continuation bits on every byte: a varint longer than 64 bits
+        uint8_t* data = reinterpret_cast<uint8_t*>(table(block, columns));
+        std::memset(data, 0xFF, *table(block, 0));
+    });
+    assert(!readsCleanly(damaged, rows));
+    
+    std::remove(damaged.c_str());
+    std::remove(path.c_str());
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_write_failure_reported() {
+    std::cout << "=== Testing Recorder Write Failure ===\n";
+    std::string path = tempPath("recorder_full");
+    RecorderLayout layout;
+    const size_t columns = layout.columns();
+    
+    // A file size limit makes writes fail with EFBIG, as a full disk would
+    // with ENOSPC
+    rlimit saved;
+    assert(::getrlimit(RLIMIT_FSIZE, &saved) == 0);
+    rlimit limited = saved;
+    limited.rlim_cur = 16384;
+    auto old_handler = std::signal(SIGXFSZ, SIG_IGN);
+    assert(::setrlimit(RLIMIT_FSIZE, &limited) == 0);
+    {
+        BookRecorder recorder(path, layout, 100);
+        std::vector<int64_t> row(columns);
+        for (int64_t r = 0; r < 20000; ++r) {
+            for (size_t c = 0; c < columns; ++c) row[c] = r * 7919 * static_cast<int64_t>(c + 1);
+            recorder.record(row.data());
+        }
+        recorder.flush();
+        assert(recorder.failed());
+        assert(recorder.rowsWritten() < 20000);
+    }
+    assert(::setrlimit(RLIMIT_FSIZE, &saved) == 0);
+    std::signal(SIGXFSZ, old_handler);
+    
+    // Unwritable from the start fails loudly instead
+    bool threw = false;
+    try {
+        BookRecorder recorder("/dev/full", layout);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::remove(path.c_str());
+    std::cout << "  ✓ PASS\n\n";
+}
+
+int main() {
+    test_round_trip();
+    test_summarize_book();
+    test_rejects_damage();
+    test_write_failure_reported();
+    std::cout << "All tests passed! ✓\n";
+    return 0;
+}
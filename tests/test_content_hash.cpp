@@ -0,0 +1,29 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include "../include/content_hash.hpp"
+
+void test_reference_vectors() {
+    std::cout << "=== Testing XXH64 Reference Vectors ===\n";
+    assert(content_hash::xxh64("") == 0xEF46DB3751D8E999ull);
+    assert(content_hash::xxh64("abc") == 0x44BC2CF5AD770999ull);
+    assert(content_hash::xxh64("Nobody inspects the spammish repetition") == 0xFBCEA83C8A378BF1ull);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_detects_single_byte_change() {
+    std::cout << "=== Testing Body Change Detection ===\n";
+    std::string body = "{\"bids\":[[\"103367.50\",\"0.5\",1]],\"asks\":[[\"103368.00\",\"1.2\",3]]}";
+    uint64_t before = content_hash::xxh64(body);
+    assert(content_hash::xxh64(body) == before);
+    body[body.size() / 2] ^= 1;
+    assert(content_hash::xxh64(body) != before);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+int main() {
+    test_reference_vectors();
+    test_detects_single_byte_change();
+    std::cout << "All tests passed! ✓\n";
+    return 0;
+}
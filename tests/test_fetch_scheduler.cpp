@@ -0,0 +1,182 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <deque>
+#include <vector>
+#include "../include/fetch_scheduler.hpp"
+
+using Clock = FetchScheduler::Clock;
+using std::chrono::milliseconds;
+
+struct SimVenue {
+    const char* name;
+    VenueBudget budget;
+    int latency_ms;
+};
+
+struct SimResult {
+    std::vector<std::vector<Clock::time_point>> sends;
+    double worst_age_ms;
+};
+
+// Discrete-time simulation: every request takes the venue's fixed latency
+static SimResult simulate(FetchScheduler& scheduler, const std::vector<SimVenue>& venues,
+                          int duration_ms) {
+    const Clock::time_point t0{};
+    for (const auto& v : venues) {
+        scheduler.addVenue(v.name, v.budget, t0);
+    }
+    
+    SimResult result;
+    result.sends.resize(venues.size());
+    std::vector<Clock::time_point> sent(venues.size());
+    std::vector<Clock::time_point> arrives(venues.size(), Clock::time_point::max());
+    
+    for (int ms = 0; ms <= duration_ms; ++ms) {
+        Clock::time_point now = t0 + milliseconds(ms);
+        for (size_t i = 0; i < venues.size(); ++i) {
+            if (arrives[i] <= now) {
+                scheduler.onComplete(i, sent[i], now, true);
+                arrives[i] = Clock::time_point::max();
+            }
+        }
+        for (size_t i : scheduler.due(now)) {
+            assert(arrives[i] == Clock::time_point::max());  // One in flight per venue
+            sent[i] = now;
+            arrives[i] = now + milliseconds(venues[i].latency_ms);
+            result.sends[i].push_back(now);
+        }
+    }
+    result.worst_age_ms = scheduler.worstAgeMs(t0 + milliseconds(duration_ms));
+    return result;
+}
+
+static std::vector<SimVenue> mixedVenues() {
+    VenueBudget fast;
+    fast.requests_per_second = 10;
+    fast.burst_limit = 15;
+    
+    VenueBudget slow;
+    slow.requests_per_second = 1;
+    slow.burst_limit = 5;
+    
+    VenueBudget weighted;  // Binance-style: 6000 weight/min, 50 per depth request
+    weighted.requests_per_second = 20;
+    weighted.burst_limit = 50;
+    weighted.weight_limit = 6000;
+    weighted.request_weight = 50;
+    
+    return {{"fast", fast, 80}, {"slow", slow, 300}, {"weighted", weighted, 50}};
+}
+
+void test_respects_budgets() {
+    std::cout << "=== Testing Per-Venue Budgets ===\n";
+    FetchScheduler scheduler(0.8);
+    auto venues = mixedVenues();
+    SimResult sim = simulate(scheduler, venues, 60000);
+    
+    for (size_t i = 0; i < venues.size(); ++i) {
+        const auto& sends = sim.sends[i];
+        const auto& budget = venues[i].budget;
+        
+        // Token bucket bound: any 1 s window holds at most burst + rate requests
+        for (size_t a = 0, b = 0; b < sends.size(); ++b) {
+            while (sends[b] - sends[a] >= milliseconds(1000)) ++a;
+            assert(static_cast<double>(b - a + 1) <= budget.burst_limit + budget.requests_per_second);
+        }
+        if (budget.weight_limit > 0) {
+            double weight_per_minute = sends.size() * budget.request_weight;
+            assert(weight_per_minute <= budget.weight_limit);
+        }
+    }
+    
+    // Cadence follows each budget (80% utilisation) instead of a shared 2 s
+    assert(sim.sends[0].size() > 400);                                // ~8/s, latency-bound
+    assert(sim.sends[1].size() >= 45 && sim.sends[1].size() <= 50);   // 0.8/s
+    assert(sim.sends[2].size() >= 94 && sim.sends[2].size() <= 98);   // weight-bound 1.6/s
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_beats_lockstep() {
+    std::cout << "=== Testing Worst-Case Age vs Lockstep 2000 ms ===\n";
+    FetchScheduler scheduler(0.8);
+    auto venues = mixedVenues();
+    SimResult sim = simulate(scheduler, venues, 60000);
+    
+    // Lockstep: every venue every 2000 ms, so the slowest responder's book
+    // peaks at interval + latency
+    double lockstep_worst = 2000 + 300;
+    
+    auto end = Clock::time_point{} + milliseconds(60000);
+    auto fast = scheduler.metrics(0, end);
+    auto slow = scheduler.metrics(1, end);
+    assert(fast.worst_age_ms < 250);         // 125 ms cadence + 80 ms latency, plus midpoint slack
+    assert(slow.worst_age_ms < 1600);
+    assert(sim.worst_age_ms < lockstep_worst);
+    assert(fast.mean_age_ms < fast.worst_age_ms && fast.mean_age_ms > 0);
+    assert(std::abs(fast.latency_ms - 80) < 1e-6);
+    
+    std::cout << "  Worst age: " << sim.worst_age_ms << " ms (lockstep: " << lockstep_worst << " ms)\n";
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_stalest_first() {
+    std::cout << "=== Testing Stalest-First Under a Concurrency Cap ===\n";
+    FetchScheduler scheduler(1.0, 1);
+    VenueBudget budget;
+    budget.requests_per_second = 1;
+    budget.burst_limit = 1;
+    const Clock::time_point t0{};
+    scheduler.addVenue("a", budget, t0);
+    scheduler.addVenue("b", budget, t0);
+    
+    auto first = scheduler.due(t0);
+    assert(first.size() == 1);
+    assert(scheduler.due(t0).empty());  // Cap reached
+    assert(scheduler.nextWakeup(t0) == Clock::time_point::max());
+    scheduler.onComplete(first[0], t0, t0 + milliseconds(100), true);
+    
+    auto second = scheduler.due(t0 + milliseconds(100));
+    assert(second.size() == 1 && second[0] != first[0]);  // The venue with no book yet
+    scheduler.onComplete(second[0], t0 + milliseconds(100), t0 + milliseconds(200), true);
+    
+    // Both due at 2 s with equal latency; the venue refreshed earliest is the stalest
+    auto third = scheduler.due(t0 + milliseconds(2000));
+    assert(third.size() == 1 && third[0] == first[0]);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_failure_retry() {
+    std::cout << "=== Testing Failure Retry Uses Burst Once ===\n";
+    FetchScheduler scheduler(1.0);
+    VenueBudget budget;
+    budget.requests_per_second = 1;
+    budget.burst_limit = 3;
+    const Clock::time_point t0{};
+    scheduler.addVenue("v", budget, t0);
+    
+    assert(scheduler.due(t0).size() == 1);
+    scheduler.onComplete(0, t0, t0 + milliseconds(50), false);
+    
+    // First failure: retry immediately from the burst allowance
+    assert(scheduler.due(t0 + milliseconds(50)).size() == 1);
+    scheduler.onComplete(0, t0 + milliseconds(50), t0 + milliseconds(100), false);
+    
+    // Second consecutive failure: back to the regular 1 s cadence
+    assert(scheduler.due(t0 + milliseconds(100)).empty());
+    assert(scheduler.nextWakeup(t0 + milliseconds(100)) == t0 + milliseconds(1050));
+    assert(scheduler.due(t0 + milliseconds(1050)).size() == 1);
+    
+    auto m = scheduler.metrics(0, t0 + milliseconds(1100));
+    assert(m.failures == 2 && m.requests == 3 && m.age_ms < 0);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+int main() {
+    test_respects_budgets();
+    test_beats_lockstep();
+    test_stalest_first();
+    test_failure_retry();
+    std::cout << "All tests passed! ✓\n";
+    return 0;
+}
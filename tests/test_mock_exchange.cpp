@@ -0,0 +1,192 @@
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include "../include/http_client.hpp"
+#include "../include/mock_exchange.hpp"
+#include "../include/venue_registry.hpp"
+
+using venues::Registry;
+
+static std::string tempPath(const char* name) {
+    return std::string("/tmp/test_mock_exchange_") + std::to_string(::getpid()) + "_" + name;
+}
+
+static MockVenueConfig venue(Exchange id, size_t depth) {
+    MockVenueConfig config;
+    config.venue = id;
+    config.depth = depth;
+    return config;
+}
+
+void test_serves_every_format() {
+    std::cout << "=== Testing Mock Serves Every Venue Format ===\n";
+    MockServerConfig config;
+    for (Exchange id : {Exchange::COINBASE, Exchange::GEMINI, Exchange::BINANCE, Exchange::KRAKEN}) {
+        config.venues.push_back(venue(id, 50));
+    }
+    MockExchangeServer server(config);
+    assert(server.port() != 0);
+    
+    // The written config points every registered venue at the mock
+    std::string path = tempPath("exchanges.json");
+    assert(server.writeConfig(path));
+    Registry registry;
+    registry.activate(Registry::selectFromConfig(path));
+    std::remove(path.c_str());
+    assert(registry.size() == 4);
+    
+    for (size_t i = 0; i < registry.size(); ++i) {
+        assert(registry.url(i) == server.urlFor(registry.id(i)));
+        OrderBookSnapshot snapshot = registry.fetch(i);
+        assert(snapshot.success && !snapshot.unchanged);
+        assert(snapshot.bids.size() == 50 && snapshot.asks.size() == 50);
+        assert(snapshot.bids[0].price < snapshot.asks[0].price);
+        assert(snapshot.bids[0].exchange == registry.id(i));
+    
+        // No churn: the ETag still matches, so the next poll is a 304
+        OrderBookSnapshot again = registry.fetch(i);
+        assert(again.success && again.unchanged);
+    }
+    assert(server.notModified() == 4);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_churn_changes_book() {
+    std::cout << "=== Testing Churn Changes The Book ===\n";
+    MockServerConfig config;
+    config.venues.push_back(venue(Exchange::COINBASE, 200));
+    config.venues.back().churn = 0.05;
+    MockExchangeServer server(config);
+    
+    venues::VenueClient<venues::Coinbase> client;
+    client.setUrl(server.urlFor(Exchange::COINBASE));
+    OrderBookSnapshot first = client.fetchOrderBook();
+    OrderBookSnapshot second = client.fetchOrderBook();
+    assert(first.success && second.success && !second.unchanged);
+    
+    size_t changed = 0;
+    for (size_t i = 0; i < first.bids.size(); ++i) {
+        changed += first.bids[i].size != second.bids[i].size;
+        changed += first.asks[i].size != second.asks[i].size;
+    }
+    assert(changed > 0 && changed <= 20);  // 5% of 400 levels, some may repeat
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_errors_latency_and_fixture() {
+    std::cout << "=== Testing Injected Errors, Latency And Fixtures ===\n";
+    std::string fixture = tempPath("gemini.json");
+    std::ofstream(fixture) << R"({"bids":[{"price":"100.00","amount":"1"}],"asks":[{"price":"101.00","amount":"2"}]})";
+    
+    MockServerConfig config;
+    config.venues.push_back(venue(Exchange::COINBASE, 10));
+    config.venues.back().error_rate = 1.0;
+    config.venues.push_back(venue(Exchange::GEMINI, 0));
+    config.venues.back().fixture_path = fixture;
+    config.venues.back().latency.median_ms = 30.0;
+    MockExchangeServer server(config);
+    std::remove(fixture.c_str());
+    
+    venues::VenueClient<venues::Coinbase> failing;
+    failing.setUrl(server.urlFor(Exchange::COINBASE));
+    OrderBookSnapshot failed = failing.fetchOrderBook();
+    assert(!failed.success && failed.error_detail == 503);
+    assert(server.injectedErrors() == 1);
+    
+    venues::VenueClient<venues::Gemini> slow;
+    slow.setUrl(server.urlFor(Exchange::GEMINI));
+    auto start = std::chrono::steady_clock::now();
+    OrderBookSnapshot served = slow.fetchOrderBook();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    assert(elapsed >= std::chrono::milliseconds(30));
+    assert(served.success && served.bids.size() == 1 && served.asks[0].size == 2 * QUANTITY_SCALE);
+    
+    // Unknown fixture is a constructor error, not a silent empty venue
+    MockServerConfig missing;
+    missing.venues.push_back(venue(Exchange::GEMINI, 0));
+    missing.venues.back().fixture_path = "/nonexistent/fixture.json";
+    bool threw = false;
+    try {
+        MockExchangeServer bad(missing);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_conditional_fetch_outcomes() {
+    std::cout << "=== Testing Identical Body And 304 Outcomes ===\n";
+    MockServerConfig config;
+    config.venues.push_back(venue(Exchange::GEMINI, 20));
+    config.venues.back().validators = false;
+    config.venues.push_back(venue(Exchange::COINBASE, 20));
+    MockExchangeServer server(config);
+    
+    // No validators (Gemini's case): every poll is a full 200, and only
+    // the body hash notices that nothing changed
+    ConditionalFetcher fetcher(server.urlFor(Exchange::GEMINI));
+    std::string body;
+    auto first = fetcher.fetch(2000, body);
+    assert(first && *first == FetchOutcome::CHANGED && !body.empty());
+    std::string repeat;
+    auto second = fetcher.fetch(2000, repeat);
+    assert(second && *second == FetchOutcome::UNCHANGED_BODY && repeat.empty());
+    assert(fetcher.stats().changed.load() == 1 && fetcher.stats().unchanged_body.load() == 1);
+    assert(fetcher.stats().not_modified.load() == 0 && server.notModified() == 0);
+    
+    // Through the venue client the repeat leaves the book as it is
+    venues::VenueClient<venues::Gemini> gemini;
+    gemini.setUrl(server.urlFor(Exchange::GEMINI));
+    assert(gemini.fetchOrderBook().success);
+    OrderBookSnapshot again = gemini.fetchOrderBook();
+    assert(again.success && again.unchanged && gemini.stats().unchanged_body.load() == 1);
+    
+    // A 304 with no remembered body has nothing to reuse: it is an HTTP
+    // error, not NOT_MODIFIED
+    HTTPClient client;
+    ConditionalState state;
+    auto fresh = client.getIfChanged(server.urlFor(Exchange::COINBASE), 2000, state, body);
+    assert(fresh && *fresh == FetchOutcome::CHANGED && !state.etag.empty());
+    ConditionalState orphan;
+    orphan.etag = state.etag;
+    auto orphaned = client.getIfChanged(server.urlFor(Exchange::COINBASE), 2000, orphan, body);
+    assert(!orphaned && orphaned.error() == ErrorCode::HTTP_STATUS && orphaned.detail() == 304);
+    auto cached = client.getIfChanged(server.urlFor(Exchange::COINBASE), 2000, state, body);
+    assert(cached && *cached == FetchOutcome::NOT_MODIFIED);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_latency_model() {
+    std::cout << "=== Testing Latency Model Percentiles ===\n";
+    LatencyModel model{10.0, 50.0};
+    std::mt19937_64 rng(3);
+    std::vector<double> samples(20000);
+    for (double& sample : samples) sample = model.sampleMs(rng);
+    std::sort(samples.begin(), samples.end());
+    double median = samples[samples.size() / 2];
+    double p99 = samples[samples.size() * 99 / 100];
+    assert(median > 9.0 && median < 11.0);
+    assert(p99 > 42.0 && p99 < 58.0);
+    
+    LatencyModel fixed{5.0, 0.0};
+    assert(fixed.sampleMs(rng) == 5.0);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+int main() {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    test_serves_every_format();
+    test_churn_changes_book();
+    test_errors_latency_and_fixture();
+    test_conditional_fetch_outcomes();
+    test_latency_model();
+    curl_global_cleanup();
+    std::cout << "All tests passed! ✓\n";
+    return 0;
+}
@@ -0,0 +1,191 @@
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <random>
+#include <vector>
+#include "../include/execution_walker.hpp"
+#include "../include/huge_page_arena.hpp"
+#include "../include/order_book.hpp"
+
+// The multimap layout the column storage replaced, as the reference for
+// ordering (equal prices stay in insertion order)
+struct ReferenceBook {
+    std::multimap<Price, PriceLevel, std::greater<Price>> bids;
+    std::multimap<Price, PriceLevel> asks;
+
+    template<typename Levels>
+    static void set(Levels& levels, Price price, Quantity size, Exchange exchange) {
+        auto [first, last] = levels.equal_range(price);
+        for (auto it = first; it != last; ++it) {
+            if (it->second.exchange == exchange) {
+                if (size == 0) {
+                    levels.erase(it);
+                } else {
+                    it->second.size = size;
+                }
+                return;
+            }
+        }
+        if (size != 0) levels.emplace_hint(last, price, PriceLevel(price, size, exchange));
+    }
+
+    template<typename Levels>
+    static void replace(Levels& levels, Exchange exchange, const std::vector<PriceLevel>& fresh) {
+        for (auto it = levels.begin(); it != levels.end();) {
+            it = it->second.exchange == exchange ? levels.erase(it) : std::next(it);
+        }
+        for (const auto& level : fresh) levels.emplace(level.price, level);
+    }
+};
+
+template<typename Levels>
+static bool sameLevels(const std::vector<PriceLevel>& got, const Levels& expected) {
+    if (got.size() != expected.size()) return false;
+    size_t i = 0;
+    for (const auto& [price, level] : expected) {
+        const PriceLevel& actual = got[i++];
+        if (actual.price != level.price || actual.size != level.size || actual.exchange != level.exchange) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static std::vector<PriceLevel> randomLevels(std::mt19937_64& rng, size_t count, Exchange exchange) {
+    std::vector<PriceLevel> levels;
+    for (size_t i = 0; i < count; ++i) {
+        // Narrow price range so equal prices across venues are common
+        levels.emplace_back(10000 + static_cast<Price>(rng() % 200), 1 + static_cast<Quantity>(rng() % 1000), exchange);
+    }
+    return levels;
+}
+
+void test_matches_multimap_reference() {
+    std::cout << "=== Testing Column Book Against Multimap Reference ===\n";
+    std::mt19937_64 rng(99);
+    OrderBook book;
+    ReferenceBook ref;
+    const Exchange venues[] = {Exchange::COINBASE, Exchange::GEMINI, Exchange::BINANCE, Exchange::KRAKEN};
+
+    for (int step = 0; step < 3000; ++step) {
+        Exchange venue = venues[rng() % 4];
+        Price price = 10000 + static_cast<Price>(rng() % 200);
+        Quantity size = static_cast<Quantity>(rng() % 4) * 100;  // 0 removes
+        switch (rng() % 7) {
+            case 0: {
+                auto bids = randomLevels(rng, rng() % 300, venue);
+                auto asks = randomLevels(rng, rng() % 300, venue);
+                book.replaceExchange(venue, bids, asks);
+                ReferenceBook::replace(ref.bids, venue, bids);
+                ReferenceBook::replace(ref.asks, venue, asks);
+                break;
+            }
+            case 1: {
+                auto levels = randomLevels(rng, rng() % 50, venue);
+                book.mergeAsks(levels);
+                for (const auto& level : levels) ref.asks.emplace(level.price, level);
+                break;
+            }
+            case 2:
+                book.addBid(price, size + 1, venue);
+                ref.bids.emplace(price, PriceLevel(price, size + 1, venue));
+                break;
+            case 3:
+                book.setBidLevel(price, size, venue);
+                ReferenceBook::set(ref.bids, price, size, venue);
+                break;
+            default:
+                book.setAskLevel(price, size, venue);
+                ReferenceBook::set(ref.asks, price, size, venue);
+                break;
+        }
+        if (step == 1500) {
+            book.clear();
+            ref.bids.clear();
+            ref.asks.clear();
+        }
+        if (step % 50 == 0) {
+            assert(sameLevels(book.getBids(), ref.bids));
+            assert(sameLevels(book.getAsks(), ref.asks));
+        }
+    }
+    assert(sameLevels(book.getBids(), ref.bids));
+    assert(sameLevels(book.getAsks(), ref.asks));
+    assert(book.bidDepth() == ref.bids.size() && book.askDepth() == ref.asks.size());
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_column_view() {
+    std::cout << "=== Testing Cache-Line Aligned Column View ===\n";
+    std::mt19937_64 rng(3);
+    OrderBook book;
+    book.replaceExchange(Exchange::COINBASE, randomLevels(rng, 5000, Exchange::COINBASE),
+                         randomLevels(rng, 5000, Exchange::COINBASE));
+    book.replaceExchange(Exchange::GEMINI, randomLevels(rng, 3000, Exchange::GEMINI),
+                         randomLevels(rng, 3000, Exchange::GEMINI));
+
+    std::vector<PriceLevel> asks = book.getAsks();
+    book.readAsks([&](const BookSideView& view) {
+        assert(view.count == asks.size());
+        assert(reinterpret_cast<uintptr_t>(view.prices) % kCacheLineSize == 0);
+        assert(reinterpret_cast<uintptr_t>(view.sizes) % kCacheLineSize == 0);
+        assert(reinterpret_cast<uintptr_t>(view.venues) % kCacheLineSize == 0);
+        for (size_t i = 0; i < view.count; ++i) {
+            assert(view.prices[i] == asks[i].price && view.sizes[i] == asks[i].size);
+            assert(view.venues[i] == asks[i].exchange);
+        }
+        for (Quantity qty : {Quantity{1}, Quantity{50000}, Quantity{100000000}}) {
+            auto columns = execution::ExecutionWalker<execution::AskSide>::walkColumns(
+                view.prices, view.sizes, view.count, qty);
+            auto copied = PriceCalculator::calculateBuyPrice(asks, qty);
+            assert(columns.total_cost == copied.total_cost);
+            assert(columns.quantity_filled == copied.quantity_filled);
+            assert(columns.error == copied.error);
+        }
+        return 0;
+    });
+
+    OrderBook empty;
+    auto none = empty.readBids([](const BookSideView& view) {
+        return execution::ExecutionWalker<execution::BidSide>::walkColumns(
+            view.prices, view.sizes, view.count, 100);
+    });
+    assert(none.error == ErrorCode::NO_BIDS);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_huge_page_arena() {
+    std::cout << "=== Testing Huge Page Arena ===\n";
+    HugePageArena arena;
+    void* first = arena.allocate(100);
+    void* second = arena.allocate(10, 4096);
+    assert(reinterpret_cast<uintptr_t>(first) % kCacheLineSize == 0);
+    assert(reinterpret_cast<uintptr_t>(second) % 4096 == 0);
+    assert(arena.reserved() == kHugePageSize);
+
+    // Spilling into a second chunk, then reset() settles on one that fits
+    arena.allocate(3 * kHugePageSize);
+    assert(arena.reserved() > 3 * kHugePageSize);
+    arena.reset();
+    arena.allocate(3 * kHugePageSize + 200);
+    assert(arena.reserved() >= 3 * kHugePageSize + 200 && arena.reserved() <= 4 * kHugePageSize);
+    std::cout << "  backing: " << HugePageArena::backingName(arena.backing()) << "\n";
+
+    HugePageArena small(HugePageArena::Backing::SMALL_PAGES);
+    small.allocate(1);
+    assert(small.backing() == HugePageArena::Backing::SMALL_PAGES);
+    OrderBook book(HugePageArena::Backing::SMALL_PAGES);
+    book.addAsk(100, 1, Exchange::COINBASE);
+    assert(book.backing() == HugePageArena::Backing::SMALL_PAGES);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+int main() {
+    test_matches_multimap_reference();
+    test_column_view();
+    test_huge_page_arena();
+    std::cout << "All tests passed! ✓\n";
+    return 0;
+}
@@ -0,0 +1,318 @@
+#include <iostream>
+#include <cassert>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include "../include/price_calculator.hpp"
+#include "../include/execution_walker.hpp"
+
+__extension__ typedef __int128 Int128;
+__extension__ typedef unsigned __int128 UInt128;
+
+// Exact cents x satoshis total rounded half up, the pricing contract
+static int64_t exactCents(Int128 raw) {
+    return static_cast<int64_t>((raw + QUANTITY_SCALE / 2) / QUANTITY_SCALE);
+}
+
+// Straightforward per-level walk used as the reference implementation
+static ExecutionResult referenceWalk(std::vector<PriceLevel> levels, Quantity quantity, bool buy) {
+    std::sort(levels.begin(), levels.end(), [buy](const PriceLevel& a, const PriceLevel& b) {
+        return buy ? a.price < b.price : a.price > b.price;
+    });
+    ExecutionResult result{0, 0, false, ErrorCode::OK};
+    Quantity remaining = quantity;
+    Int128 raw = 0;
+    for (const auto& level : levels) {
+        if (remaining <= 0) break;
+        Quantity fill = std::min(remaining, level.size);
+        raw += static_cast<Int128>(level.price) * fill;
+        result.quantity_filled += fill;
+        remaining -= fill;
+    }
+    result.total_cost = exactCents(raw);
+    result.fully_filled = (remaining == 0);
+    return result;
+}
+
+static std::vector<PriceLevel> randomBook(std::mt19937_64& rng, size_t depth, Price start, Price step) {
+    std::uniform_int_distribution<Quantity> size_dist(1, 3 * QUANTITY_SCALE);
+    std::vector<PriceLevel> levels;
+    levels.reserve(depth);
+    for (size_t i = 0; i < depth; ++i) {
+        levels.emplace_back(start + static_cast<Price>(i) * step, size_dist(rng),
+                            i % 2 ? Exchange::GEMINI : Exchange::COINBASE);
+    }
+    return levels;
+}
+
+void test_crossing_scan() {
+    std::cout << "=== Testing SIMD Crossing Scan ===\n";
+    std::mt19937_64 rng(7);
+    for (size_t n : {0u, 1u, 3u, 4u, 7u, 8u, 9u, 31u, 64u, 1000u}) {
+        std::vector<Quantity> sizes(n);
+        std::uniform_int_distribution<Quantity> dist(0, 1000);
+        for (auto& s : sizes) s = dist(rng);
+        Quantity total = 0;
+        for (auto s : sizes) total += s;
+        for (Quantity target : {Quantity{1}, total / 3, total, total + 1}) {
+            auto fast = execution::findCrossing<1>(sizes.data(), n, target);
+            auto slow = execution::findCrossingScalar<1>(sizes.data(), n, target);
+            assert(fast.index == slow.index);
+            assert(fast.consumed_before == slow.consumed_before);
+        }
+    }
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_walker_matches_reference() {
+    std::cout << "=== Testing Walker Against Reference ===\n";
+    std::mt19937_64 rng(42);
+    for (size_t depth : {1u, 5u, 50u, 1000u}) {
+        auto asks = randomBook(rng, depth, 10000000, 50);
+        auto bids = randomBook(rng, depth, 9999950, -50);
+        for (Quantity qty : {Quantity{1}, QUANTITY_SCALE, 10 * QUANTITY_SCALE,
+                             static_cast<Quantity>(depth) * 4 * QUANTITY_SCALE}) {
+            auto buy = PriceCalculator::calculateBuyPrice(asks, qty);
+            auto ref_buy = referenceWalk(asks, qty, true);
+            assert(buy.total_cost == ref_buy.total_cost);
+            assert(buy.quantity_filled == ref_buy.quantity_filled);
+            assert(buy.fully_filled == ref_buy.fully_filled);
+
+            auto sell = PriceCalculator::calculateSellPrice(bids, qty);
+            auto ref_sell = referenceWalk(bids, qty, false);
+            assert(sell.total_cost == ref_sell.total_cost);
+            assert(sell.quantity_filled == ref_sell.quantity_filled);
+            assert(sell.fully_filled == ref_sell.fully_filled);
+        }
+
+        // Unsorted input must still be walked best-first
+        std::shuffle(asks.begin(), asks.end(), rng);
+        auto shuffled = PriceCalculator::calculateBuyPrice(asks, 10 * QUANTITY_SCALE);
+        auto ref = referenceWalk(asks, 10 * QUANTITY_SCALE, true);
+        assert(shuffled.total_cost == ref.total_cost);
+    }
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_edge_cases() {
+    std::cout << "=== Testing Edge Cases ===\n";
+    std::vector<PriceLevel> empty;
+    auto none = PriceCalculator::calculateBuyPrice(empty, QUANTITY_SCALE);
+    assert(!none.fully_filled && none.error == ErrorCode::NO_ASKS);
+    assert(std::string(errorMessage(none.error)) == "No asks available");
+
+    std::vector<PriceLevel> one{PriceLevel(10336750, QUANTITY_SCALE, Exchange::COINBASE)};
+    auto exact = PriceCalculator::calculateBuyPrice(one, QUANTITY_SCALE);
+    assert(exact.fully_filled && exact.total_cost == 10336750);
+
+    auto partial = PriceCalculator::calculateSellPrice(one, 2 * QUANTITY_SCALE);
+    assert(!partial.fully_filled && partial.quantity_filled == QUANTITY_SCALE);
+    assert(partial.error == ErrorCode::INSUFFICIENT_LIQUIDITY);
+    assert(exact.error == ErrorCode::OK);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_wide_notional() {
+    std::cout << "=== Testing Wide Notional Arithmetic ===\n";
+    std::mt19937_64 rng(5);
+    for (int i = 0; i < 10000; ++i) {
+        uint64_t a = rng(), b = rng() >> (i % 64);
+        auto native = fixed_point::mulWide(a, b);
+        auto portable = fixed_point::mulWidePortable(a, b);
+        UInt128 expected = static_cast<UInt128>(a) * b;
+        assert(native.hi == portable.hi && native.lo == portable.lo);
+        assert(portable.hi == static_cast<uint64_t>(expected >> 64));
+        assert(portable.lo == static_cast<uint64_t>(expected));
+    
+        fixed_point::U128 value{rng() % QUANTITY_SCALE, rng()};
+        UInt128 wide = (static_cast<UInt128>(value.hi) << 64) | value.lo;
+        assert(fixed_point::divideNarrow(value, QUANTITY_SCALE) == static_cast<uint64_t>(wide / QUANTITY_SCALE));
+    }
+    
+    // The 64-bit proof holds right up to the boundary and no further
+    Price price = 10000000;
+    Quantity limit = (INT64_MAX - QUANTITY_SCALE / 2) / price;
+    assert(fixed_point::fitsInt64(price, limit));
+    assert(!fixed_point::fitsInt64(price, limit + 1));
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_whale_sizes_and_rounding() {
+    std::cout << "=== Testing Whale Sizes And Single Rounding ===\n";
+    // 50,000 BTC at $100k: each level's product is past int64
+    std::vector<PriceLevel> asks{PriceLevel(10000000, 20000 * QUANTITY_SCALE, Exchange::COINBASE),
+                                 PriceLevel(10000050, 30000 * QUANTITY_SCALE, Exchange::GEMINI)};
+    auto whale = PriceCalculator::calculateBuyPrice(asks, 50000 * QUANTITY_SCALE);
+    assert(whale.fully_filled && whale.total_cost == 500001500000);
+    assert(whale.total_cost == referenceWalk(asks, 50000 * QUANTITY_SCALE, true).total_cost);
+    auto routed = PriceCalculator::routeBuy(asks, 50000 * QUANTITY_SCALE);
+    assert(routed.total.total_cost == whale.total_cost);
+    assert(routed.fill(Exchange::GEMINI).notional == 300001500000);
+    
+    std::vector<PriceLevel> bids{PriceLevel(10000050, 30000 * QUANTITY_SCALE, Exchange::GEMINI),
+                                 PriceLevel(10000000, 20000 * QUANTITY_SCALE, Exchange::COINBASE)};
+    auto sold = PriceCalculator::calculateSellPrice(bids, 45000 * QUANTITY_SCALE + 1);
+    assert(sold.total_cost == referenceWalk(bids, 45000 * QUANTITY_SCALE + 1, false).total_cost);
+    
+    // 1 satoshi at $100k is a tenth of a cent: truncating per level would
+    // price 4000 of them at zero
+    std::vector<PriceLevel> dust(4000, PriceLevel(10000000, 1, Exchange::KRAKEN));
+    auto crumbs = PriceCalculator::calculateBuyPrice(dust, 4000);
+    assert(crumbs.fully_filled && crumbs.total_cost == 400);
+    std::vector<PriceLevel> coins;
+    for (int i = 0; i < 3; ++i) coins.emplace_back(10000001, QUANTITY_SCALE / 2, Exchange::COINBASE);
+    auto halves = PriceCalculator::calculateBuyPrice(coins, 3 * QUANTITY_SCALE / 2);
+    assert(halves.total_cost == 15000002);  // 15000001.5 once, not 3 x 5000000
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_routing_matches_walker() {
+    std::cout << "=== Testing Per-Venue Routing Against Walker ===\n";
+    std::mt19937_64 rng(11);
+    for (size_t depth : {1u, 50u, 1000u}) {
+        auto asks = randomBook(rng, depth, 10000000, 50);
+        auto bids = randomBook(rng, depth, 9999950, -50);
+        for (Quantity qty : {Quantity{0}, Quantity{1}, 10 * QUANTITY_SCALE,
+                             static_cast<Quantity>(depth) * 4 * QUANTITY_SCALE}) {
+            auto walked = PriceCalculator::calculateBuyPrice(asks, qty);
+            auto routed = PriceCalculator::routeBuy(asks, qty);
+            assert(routed.total.total_cost == walked.total_cost);
+            assert(routed.total.quantity_filled == walked.quantity_filled);
+            assert(routed.total.fully_filled == walked.fully_filled);
+            assert(routed.total.error == walked.error);
+            assert(routed.total_fees == 0);
+            
+            // Per-venue split agrees with a straightforward re-walk
+            Quantity remaining = qty;
+            std::array<VenueFill, kRoutedVenues> expected{};
+            std::array<Int128, kRoutedVenues> raw{};
+            for (const auto& level : asks) {
+                if (remaining <= 0) break;
+                Quantity fill = std::min(remaining, level.size);
+                VenueFill& venue = expected[static_cast<size_t>(level.exchange)];
+                venue.quantity += fill;
+                raw[static_cast<size_t>(level.exchange)] += static_cast<Int128>(level.price) * fill;
+                venue.worst_price = level.price;
+                ++venue.levels;
+                remaining -= fill;
+            }
+            for (size_t v = 0; v < kRoutedVenues; ++v) {
+                assert(routed.venues[v].quantity == expected[v].quantity);
+                assert(routed.venues[v].notional == exactCents(raw[v]));
+                assert(routed.venues[v].worst_price == expected[v].worst_price);
+                assert(routed.venues[v].levels == expected[v].levels);
+            }
+            
+            auto sold = PriceCalculator::routeSell(bids, qty);
+            assert(sold.total.total_cost == PriceCalculator::calculateSellPrice(bids, qty).total_cost);
+        }
+    }
+    
+    std::vector<PriceLevel> empty;
+    assert(PriceCalculator::routeSell(empty, QUANTITY_SCALE).total.error == ErrorCode::NO_BIDS);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_fee_aware_routing() {
+    std::cout << "=== Testing Fee-Aware Routing ===\n";
+    // Coinbase is 10 cents cheaper on price but charges 60 bps; Gemini 0 bps
+    std::vector<PriceLevel> asks{
+        PriceLevel(5000000, QUANTITY_SCALE, Exchange::COINBASE),
+        PriceLevel(5000010, QUANTITY_SCALE, Exchange::GEMINI),
+        PriceLevel(5000020, QUANTITY_SCALE, Exchange::GEMINI),
+    };
+    RoutingRules rules;
+    rules[Exchange::COINBASE].taker_fee_ppm = 6000;
+    
+    auto routed = PriceCalculator::routeBuy(asks, 2 * QUANTITY_SCALE, rules);
+    assert(routed.total.fully_filled);
+    assert(routed.fill(Exchange::COINBASE).quantity == 0);
+    assert(routed.fill(Exchange::GEMINI).quantity == 2 * QUANTITY_SCALE);
+    assert(routed.fill(Exchange::GEMINI).worst_price == 5000020);
+    assert(routed.fill(Exchange::GEMINI).levels == 2);
+    assert(routed.total_fees == 0);
+    
+    // Once Gemini is exhausted the order spills onto Coinbase and pays its fee
+    auto spill = PriceCalculator::routeBuy(asks, 3 * QUANTITY_SCALE, rules);
+    assert(spill.fill(Exchange::COINBASE).quantity == QUANTITY_SCALE);
+    assert(spill.fill(Exchange::COINBASE).fee == 30000);  // 0.6% of $50,000
+    assert(spill.total_fees == 30000);
+    
+    // Selling: fees cut proceeds, so the fee-free bid wins despite a lower price
+    std::vector<PriceLevel> bids{
+        PriceLevel(5000010, QUANTITY_SCALE, Exchange::COINBASE),
+        PriceLevel(5000000, QUANTITY_SCALE, Exchange::GEMINI),
+    };
+    auto sold = PriceCalculator::routeSell(bids, QUANTITY_SCALE, rules);
+    assert(sold.fill(Exchange::GEMINI).quantity == QUANTITY_SCALE);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_min_size_reroutes() {
+    std::cout << "=== Testing Minimum Size Re-routing ===\n";
+    std::vector<PriceLevel> asks{
+        PriceLevel(5000000, QUANTITY_SCALE / 1000, Exchange::KRAKEN),  // 0.001 BTC
+        PriceLevel(5000010, 5 * QUANTITY_SCALE, Exchange::COINBASE),
+    };
+    RoutingRules rules;
+    rules[Exchange::KRAKEN].min_size = QUANTITY_SCALE / 100;  // 0.01 BTC
+    
+    auto routed = PriceCalculator::routeBuy(asks, QUANTITY_SCALE, rules);
+    assert(routed.total.fully_filled);
+    assert(routed.fill(Exchange::KRAKEN).quantity == 0);
+    assert(routed.fill(Exchange::COINBASE).quantity == QUANTITY_SCALE);
+    
+    // Without the constraint the cheaper Kraken sliver is used
+    auto free = PriceCalculator::routeBuy(asks, QUANTITY_SCALE);
+    assert(free.fill(Exchange::KRAKEN).quantity == QUANTITY_SCALE / 1000);
+    
+    // Excluded venues are never routed to
+    rules.allowed = venueBit(Exchange::KRAKEN);
+    auto kraken_only = PriceCalculator::routeBuy(asks, QUANTITY_SCALE, rules);
+    assert(!kraken_only.total.fully_filled && kraken_only.total.quantity_filled == 0);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_batch_matches_single() {
+    std::cout << "=== Testing Batch Routing ===\n";
+    std::mt19937_64 rng(5);
+    auto asks = randomBook(rng, 500, 10000000, 50);
+    RoutingRules rules;
+    rules[Exchange::GEMINI].taker_fee_ppm = 1000;
+    rules[Exchange::COINBASE].min_size = QUANTITY_SCALE / 2;
+    
+    std::vector<Quantity> sizes;
+    std::uniform_int_distribution<Quantity> size_dist(0, 800 * QUANTITY_SCALE);
+    for (int i = 0; i < 64; ++i) sizes.push_back(size_dist(rng));
+    sizes.push_back(1);  // Small enough to trip Coinbase's minimum
+    
+    std::vector<RoutedExecution> batch;
+    PriceCalculator::routeBuyBatch(asks, sizes, rules, batch);  // Unsorted sizes
+    assert(batch.size() == sizes.size());
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        auto single = PriceCalculator::routeBuy(asks, sizes[i], rules);
+        assert(batch[i].total.total_cost == single.total.total_cost);
+        assert(batch[i].total.quantity_filled == single.total.quantity_filled);
+        assert(batch[i].total_fees == single.total_fees);
+        for (size_t v = 0; v < kRoutedVenues; ++v) {
+            assert(batch[i].venues[v].quantity == single.venues[v].quantity);
+            assert(batch[i].venues[v].levels == single.venues[v].levels);
+        }
+    }
+    std::cout << "  ✓ PASS\n\n";
+}
+
+int main() {
+    test_crossing_scan();
+    test_walker_matches_reference();
+    test_edge_cases();
+    test_wide_notional();
+    test_whale_sizes_and_rounding();
+    test_routing_matches_walker();
+    test_fee_aware_routing();
+    test_min_size_reroutes();
+    test_batch_matches_single();
+    std::cout << "All tests passed! ✓\n";
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <cassert>
+#include "../include/quote_cache.hpp"
+
+static void fillBook(OrderBook& book) {
+    book.addAsk(10000000, QUANTITY_SCALE, Exchange::COINBASE);
+    book.addAsk(10000100, QUANTITY_SCALE, Exchange::GEMINI);
+    book.addAsk(10000200, 5 * QUANTITY_SCALE, Exchange::COINBASE);
+    book.addBid(9999900, 2 * QUANTITY_SCALE, Exchange::GEMINI);
+    book.addBid(9999800, 3 * QUANTITY_SCALE, Exchange::COINBASE);
+}
+
+void test_hits_and_misses() {
+    std::cout << "=== Testing Quote Cache Hits/Misses ===\n";
+    OrderBook book;
+    fillBook(book);
+    QuoteCache cache(book);
+    
+    auto first = cache.quote(QuoteSide::BUY, 2 * QUANTITY_SCALE);
+    auto second = cache.quote(QuoteSide::BUY, 2 * QUANTITY_SCALE);
+    assert(first.total_cost == second.total_cost);
+    assert(first.total_cost == 20000100);
+    assert(cache.hits() == 1 && cache.misses() == 1);
+    
+    // Different side / quantity / venue filter are distinct keys
+    cache.quote(QuoteSide::SELL, 2 * QUANTITY_SCALE);
+    cache.quote(QuoteSide::BUY, 3 * QUANTITY_SCALE);
+    cache.quote(QuoteSide::BUY, 2 * QUANTITY_SCALE, venueBit(Exchange::COINBASE));
+    assert(cache.misses() == 4 && cache.size() == 4);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_venue_filter() {
+    std::cout << "=== Testing Venue Filter ===\n";
+    OrderBook book;
+    fillBook(book);
+    QuoteCache cache(book);
+    
+    // Coinbase only: 1 BTC @ 100000.00 + 1 BTC @ 100002.00
+    auto coinbase = cache.quote(QuoteSide::BUY, 2 * QUANTITY_SCALE, venueBit(Exchange::COINBASE));
+    assert(coinbase.fully_filled && coinbase.total_cost == 20000200);
+    
+    auto gemini = cache.quote(QuoteSide::BUY, 2 * QUANTITY_SCALE, venueBit(Exchange::GEMINI));
+    assert(!gemini.fully_filled && gemini.quantity_filled == QUANTITY_SCALE);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_invalidation_on_version_change() {
+    std::cout << "=== Testing Invalidation ===\n";
+    OrderBook book;
+    fillBook(book);
+    QuoteCache cache(book);
+    
+    auto before = cache.quote(QuoteSide::BUY, QUANTITY_SCALE);
+    assert(cache.size() == 1);
+    
+    book.addAsk(9000000, QUANTITY_SCALE, Exchange::GEMINI);
+    auto after = cache.quote(QuoteSide::BUY, QUANTITY_SCALE);
+    assert(after.total_cost == 9000000 && after.total_cost != before.total_cost);
+    assert(cache.hits() == 0 && cache.misses() == 2 && cache.size() == 1);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+int main() {
+    test_hits_and_misses();
+    test_venue_filter();
+    test_invalidation_on_version_change();
+    std::cout << "All tests passed! ✓\n";
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "../include/thread_runtime.hpp"
+#include "../include/work_stealing_pool.hpp"
+
+static std::string tempPath(const char* name) {
+    return std::string("/tmp/test_thread_runtime_") + std::to_string(::getpid()) + "_" + name;
+}
+
+static RuntimeConfig loadFrom(const std::string& contents) {
+    std::string path = tempPath("exchanges.json");
+    std::ofstream(path) << contents;
+    RuntimeConfig config = RuntimeConfig::load(path);
+    std::remove(path.c_str());
+    return config;
+}
+
+static std::string currentThreadName() {
+    char name[16] = {};
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+    return name;
+}
+
+void test_config_parsing_and_fallback() {
+    std::cout << "=== Testing Runtime Config Parsing And Fallback ===\n";
+    RuntimeConfig config = loadFrom(R"({"runtime": {"enabled": true, "busy_poll": true,
+        "parse_threads": 3, "network_cpus": [0, 1], "parse_cpus": [2, 3, 4],
+        "book_cpus": [5], "query_cpus": [6]}})");
+    assert(config.enabled && config.busy_poll && config.parse_threads == 3);
+    assert((config.network_cpus == std::vector<int>{0, 1}));
+    assert((config.parse_cpus == std::vector<int>{2, 3, 4}));
+    assert((config.book_cpus == std::vector<int>{5}) && (config.query_cpus == std::vector<int>{6}));
+
+    // Missing keys keep their defaults; empty CPU lists mean unpinned
+    RuntimeConfig partial = loadFrom(R"({"runtime": {"enabled": true}})");
+    assert(partial.enabled && !partial.busy_poll && partial.parse_threads == 0);
+    assert(partial.network_cpus.empty() && partial.book_cpus.empty());
+
+    // No section, no file, no path and bad input all fall back to disabled
+    assert(!loadFrom(R"({"exchanges": []})").enabled);
+    assert(!RuntimeConfig::load("/nonexistent/exchanges.json").enabled);
+    assert(!RuntimeConfig::load("").enabled);
+    RuntimeConfig bad_type = loadFrom(R"({"runtime": {"enabled": true, "book_cpus": ["one"]}})");
+    assert(!bad_type.enabled && bad_type.book_cpus.empty());
+    RuntimeConfig bad_json = loadFrom(R"({"runtime": {"enabled": true,)");
+    assert(!bad_json.enabled);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_invalid_cpus() {
+    std::cout << "=== Testing Pinning To Invalid CPUs ===\n";
+    // Nothing valid in the list: the kernel refuses an empty mask
+    assert(!thread_util::pinCurrentThread({-1, 1 << 20}));
+    assert(thread_util::pinCurrentThread({}));
+
+    // A worker that cannot pin still runs its tasks
+    PinnedWorker worker("obk-test-bad", {-1}, false);
+    assert(worker.submit([]() { return 7; }).get() == 7);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_work_runs_on_named_worker() {
+    std::cout << "=== Testing Work Runs On The Named Worker ===\n";
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    assert(sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+    int cpu = 0;
+    while (!CPU_ISSET(cpu, &allowed)) ++cpu;
+
+    for (bool busy_poll : {false, true}) {
+        PinnedWorker worker("obk-test-pin", {cpu}, busy_poll);
+        const pthread_t caller = pthread_self();
+        auto [name, same_thread, on_cpu] = worker.submit([&]() {
+            return std::make_tuple(currentThreadName(), pthread_equal(pthread_self(), caller) != 0, sched_getcpu());
+        }).get();
+        assert(name == "obk-test-pin" && !same_thread && on_cpu == cpu);
+
+        // Results and exceptions come back through the futures
+        std::vector<std::future<int>> results;
+        for (int i = 0; i < 100; ++i) results.push_back(worker.submit([i]() { return i * i; }));
+        for (int i = 0; i < 100; ++i) assert(results[i].get() == i * i);
+        auto failed = worker.submit([]() -> int { throw std::runtime_error("task failed"); });
+        bool threw = false;
+        try {
+            failed.get();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // Names longer than Linux's 15 characters are truncated, not rejected
+    PinnedWorker long_name("obk-a-very-long-worker-name", {}, false);
+    assert(long_name.submit(currentThreadName).get() == "obk-a-very-long");
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_runtime_threads_and_report() {
+    std::cout << "=== Testing Runtime Threads And Report ===\n";
+    RuntimeConfig config;
+    config.enabled = true;
+    config.parse_threads = 1;
+    ThreadRuntime runtime(config, 2);
+
+    assert(runtime.network(0).name() == "obk-net-0" && runtime.network(1).name() == "obk-net-1");
+    assert(&runtime.network(2) == &runtime.network(0));  // Venues beyond the pool wrap
+    assert(runtime.book().submit(currentThreadName).get() == "obk-book");
+    assert(runtime.query().submit(currentThreadName).get() == "obk-query");
+
+    // Sleeping on the book thread shows up as voluntary switches
+    for (int i = 0; i < 5; ++i) {
+        runtime.book().submit([]() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }).get();
+    }
+    bool found = false;
+    for (const auto& [name, switches] : thread_util::registeredThreadSwitches()) {
+        if (name == "obk-book") {
+            found = true;
+            assert(switches.voluntary >= 5);
+        }
+    }
+    assert(found);
+
+    // The parse pool is sized and hooked by the runtime, and starts on first use
+    assert(WorkStealingPool::instance().workerCount() == 1);
+    auto registered = [](const std::string& wanted) {
+        for (const auto& entry : thread_util::registeredThreadSwitches()) {
+            if (entry.first == wanted) return true;
+        }
+        return false;
+    };
+    for (int i = 0; i < 1000 && !registered("obk-parse-0"); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(registered("obk-parse-0"));
+
+    std::ostringstream report;
+    runtime.report(report);
+    const std::string text = report.str();
+    assert(text.rfind("Thread context switches (voluntary / involuntary):\n", 0) == 0);
+    for (const char* name : {"obk-net-0", "obk-net-1", "obk-book", "obk-query", "obk-parse-0"}) {
+        assert(text.find(std::string("  ") + name + ": ") != std::string::npos);
+    }
+    std::cout << "  ✓ PASS\n\n";
+}
+
+int main() {
+    test_config_parsing_and_fallback();
+    test_invalid_cpus();
+    test_work_runs_on_named_worker();
+    test_runtime_threads_and_report();
+    std::cout << "All tests passed! ✓\n";
+    return 0;
+}
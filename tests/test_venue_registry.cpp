@@ -0,0 +1,113 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <unistd.h>
+#include <fstream>
+#include <string>
+#include "../include/venue_registry.hpp"
+#include "../include/exchange_factory.hpp"
+
+using venues::Registry;
+
+// Slot lookup is usable in constant expressions
+static_assert(Registry::kVenueCount == 4, "registry lists Coinbase, Gemini, Binance, Kraken");
+static_assert(Registry::slotOf("coinbase") == 0, "coinbase slot");
+static_assert(Registry::slotOf("gemini") == 1, "gemini slot");
+static_assert(Registry::slotOf("bitstamp") == Registry::kVenueCount, "no bitstamp client");
+static_assert(Registry::idOfSlot(1) == Exchange::GEMINI, "gemini id");
+static_assert(Registry::isDefaultSlot(0) && !Registry::isDefaultSlot(Registry::slotOf("kraken")),
+              "only Coinbase and Gemini are polled without config");
+
+static std::string writeConfig(const std::string& body) {
+    std::string path = "/tmp/test_venue_registry_" + std::to_string(::getpid()) + ".json";
+    std::ofstream(path) << body;
+    return path;
+}
+
+void test_slots_from_config() {
+    std::cout << "=== Testing Slots From Config ===\n";
+    std::string path = writeConfig(R"({"exchanges": [
+        {"id": "gemini", "enabled": true},
+        {"id": "bitstamp", "enabled": true},
+        {"id": "kraken", "enabled": true,
+         "order_book_config": {"full_url": "http://127.0.0.1:8080/0/public/Depth?pair=XXBTZUSD"}},
+        {"id": "coinbase", "enabled": false}]})");
+    auto selected = Registry::selectFromConfig(path);
+    assert(selected.size() == 2 && selected[0].slot == Registry::slotOf("gemini"));
+    assert(selected[0].url.empty());
+    
+    Registry registry;
+    registry.activate(selected);
+    assert(registry.size() == 2);
+    assert(registry.id(0) == Exchange::GEMINI);
+    assert(std::string(registry.name(0)) == "Gemini");
+    assert(registry.url(0) == venues::Gemini::kUrl);
+    assert(registry.id(1) == Exchange::KRAKEN);
+    assert(registry.url(1) == "http://127.0.0.1:8080/0/public/Depth?pair=XXBTZUSD");
+    
+    // Nothing usable enabled falls back to the default venues
+    std::ofstream(path) << R"({"exchanges": [{"id": "bitstamp", "enabled": true}]})";
+    assert(Registry::selectFromConfig(path).size() == 2);
+    assert(Registry::selectFromConfig("/nonexistent/exchanges.json").size() == 2);
+    std::remove(path.c_str());
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_visit_routes_to_venue() {
+    std::cout << "=== Testing Visit Routes To Venue ===\n";
+    Registry registry;
+    for (size_t slot = 0; slot < Registry::kVenueCount; ++slot) {
+        Exchange seen = registry.visit(slot, [](auto& client) {
+            using Client = std::decay_t<decltype(client)>;
+            if constexpr (std::is_same_v<Client, venues::VenueClient<venues::Coinbase>>) return Exchange::COINBASE;
+            if constexpr (std::is_same_v<Client, venues::VenueClient<venues::Gemini>>) return Exchange::GEMINI;
+            if constexpr (std::is_same_v<Client, venues::VenueClient<venues::Binance>>) return Exchange::BINANCE;
+            return Exchange::KRAKEN;
+        });
+        assert(seen == Registry::idOfSlot(slot));
+    }
+    
+    auto clients = ExchangeFactory::createFromConfig("");
+    assert(clients.size() == 2);
+    assert(clients[0]->getName() == "Coinbase" && clients[1]->getExchangeId() == Exchange::GEMINI);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+void test_static_parse_matches_virtual() {
+    std::cout << "=== Testing Static Parse Matches Function-Pointer Parse ===\n";
+    const std::string coinbase = R"({"bids":[["100.50","0.5",1],["100.25","1",2]],"asks":[["101","2",1]]})";
+    OrderBookSnapshot a, b;
+    assert(venues::VenueClient<venues::Coinbase>::parse(coinbase, a) == ErrorCode::OK);
+    assert(book_parser::parseBook(coinbase, Exchange::COINBASE, book_parser::arrayLevel, b) == ErrorCode::OK);
+    assert(a.bids.size() == 2 && a.asks.size() == 1);
+    assert(a.bids[0].price == b.bids[0].price && a.bids[1].size == b.bids[1].size);
+    assert(a.bids[0].exchange == Exchange::COINBASE);
+    
+    const std::string gemini = R"({"bids":[{"price":"99.75","amount":"3"}],"asks":[{"price":"100","amount":"1"}]})";
+    OrderBookSnapshot g;
+    assert(venues::VenueClient<venues::Gemini>::parse(gemini, g) == ErrorCode::OK);
+    assert(g.bids[0].price == 9975 && g.bids[0].size == 3 * QUANTITY_SCALE);
+    assert(g.asks[0].exchange == Exchange::GEMINI);
+    
+    OrderBookSnapshot bad;
+    assert(venues::VenueClient<venues::Gemini>::parse(coinbase, bad) == ErrorCode::MALFORMED_LEVEL);
+    
+    // Kraken's book sits inside a result envelope
+    const std::string kraken = R"({"error":[],"result":{"XXBTZUSD":{
+        "asks":[["100.10","0.250",1700000000]],"bids":[["99.90","1.500",1700000000]]}}})";
+    OrderBookSnapshot k;
+    assert(venues::VenueClient<venues::Kraken>::parse(kraken, k) == ErrorCode::OK);
+    assert(k.bids.size() == 1 && k.bids[0].price == 9990 && k.asks[0].size == QUANTITY_SCALE / 4);
+    OrderBookSnapshot missing;
+    assert(venues::VenueClient<venues::Kraken>::parse(R"({"error":["EGeneral:Too many requests"]})", missing)
+           == ErrorCode::MALFORMED_JSON);
+    std::cout << "  ✓ PASS\n\n";
+}
+
+int main() {
+    test_slots_from_config();
+    test_visit_routes_to_venue();
+    test_static_parse_matches_virtual();
+    std::cout << "All tests passed! ✓\n";
+    return 0;
+}